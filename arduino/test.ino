@@ -1,5 +1,52 @@
 #define BAUD_RATE 9600
 #define DATA_INTERVAL_MS 50
+#define READINGS_PER_FRAME 32
+// Una trama parcial sale a más tardar a los 400 ms: esort considera
+// desconectado el puerto tras 1 s sin datos, y 32 x 50 ms = 1.6 s
+#define FRAME_MAX_MS 400
+
+// Formato de trama (ver include/Protocolo.h):
+// A5 5A | secuencia (4) | n (1) | n lecturas (2 c/u) | CRC-16 (2)
+uint16_t batch[READINGS_PER_FRAME];
+uint8_t batch_len = 0;
+uint32_t sequence = 0;
+unsigned long last_frame = 0;
+
+uint16_t crc16(const uint8_t* data, int len) {
+  uint16_t crc = 0xFFFF;
+  for (int i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+void sendFrame() {
+  uint8_t frame[7 + 2 * READINGS_PER_FRAME + 2];
+  int pos = 0;
+
+  frame[pos++] = 0xA5;
+  frame[pos++] = 0x5A;
+  for (int i = 0; i < 4; i++) {
+    frame[pos++] = (sequence >> (8 * i)) & 0xFF;
+  }
+  frame[pos++] = batch_len;
+  for (int i = 0; i < batch_len; i++) {
+    frame[pos++] = batch[i] & 0xFF;
+    frame[pos++] = batch[i] >> 8;
+  }
+
+  uint16_t crc = crc16(frame + 2, pos - 2);
+  frame[pos++] = crc & 0xFF;
+  frame[pos++] = crc >> 8;
+
+  Serial.write(frame, pos);
+  sequence += batch_len;
+  batch_len = 0;
+  last_frame = millis();
+}
 
 void setup() {
   Serial.begin(BAUD_RATE);
@@ -10,10 +57,16 @@ void setup() {
 
   randomSeed(analogRead(A0));
   delay(2000);
+  last_frame = millis();
 }
 
 void loop() {
   long energy_reading = random(0, 65536);
-  Serial.println(energy_reading);
+  batch[batch_len++] = (uint16_t)energy_reading;
+
+  if (batch_len == READINGS_PER_FRAME ||
+      millis() - last_frame >= FRAME_MAX_MS) {
+    sendFrame();
+  }
   delay(DATA_INTERVAL_MS);
 }
@@ -0,0 +1,65 @@
+/**
+ * @file ArbolFenwick.h
+ * @brief Árbol de Fenwick (Binary Indexed Tree) para conteos por valor
+ */
+
+#ifndef ARBOLFENWICK_H
+#define ARBOLFENWICK_H
+
+/**
+ * @class ArbolFenwick
+ * @brief Conteos por valor con sumas de prefijo y búsqueda por rango
+ * 
+ * Sobre un dominio [0, tamano) permite sumar o quitar lecturas, contar
+ * cuántas son menores o iguales a un valor y encontrar la k-ésima menor,
+ * todo en O(log tamano).
+ */
+class ArbolFenwick {
+private:
+    int* arbol;             // Sumas parciales, índices 1..tamano
+    int tamano;             // Número de valores del dominio
+    int mayor_potencia;     // Mayor potencia de 2 <= tamano
+    
+public:
+    /**
+     * @brief Constructor con todos los conteos en cero
+     * @param n Número de valores del dominio
+     */
+    ArbolFenwick(int n);
+    
+    /**
+     * @brief Destructor que libera el arreglo
+     */
+    ~ArbolFenwick();
+    
+    ArbolFenwick(const ArbolFenwick&) = delete;
+    ArbolFenwick& operator=(const ArbolFenwick&) = delete;
+    
+    /**
+     * @brief Suma delta al conteo de un valor
+     * @param valor Valor del dominio
+     * @param delta Cantidad a sumar (negativa para quitar)
+     */
+    void actualizar(int valor, int delta);
+    
+    /**
+     * @brief Cuenta las lecturas menores o iguales a un valor
+     * @param valor Valor del dominio
+     * @return Suma de conteos en [0, valor]
+     */
+    int prefijo(int valor) const;
+    
+    /**
+     * @brief Busca la k-ésima menor lectura
+     * @param k Posición (1 = la menor)
+     * @return Valor en esa posición
+     */
+    int buscarKesimo(int k) const;
+    
+    /**
+     * @brief Pone todos los conteos en cero
+     */
+    void limpiar();
+};
+
+#endif // ARBOLFENWICK_H
@@ -6,6 +6,8 @@
 #ifndef CIRCULARBUFFER_H
 #define CIRCULARBUFFER_H
 
+#include "ArbolFenwick.h"
+
 /**
  * @struct Nodo
  * @brief Nodo de la lista circular doblemente enlazada
@@ -28,12 +30,27 @@ struct Nodo {
  * 
  * Este buffer almacena datos en una lista circular y cuando se llena,
  * permite ordenar su contenido y volcarlo a un archivo.
+ * 
+ * En modo anillo funciona como ventana deslizante: al estar lleno, cada
+ * inserción sobrescribe la lectura más antigua. Un árbol de Fenwick sobre
+ * el dominio de 16 bits se actualiza en cada inserción, así mediana,
+ * percentiles y rango se responden en O(log 65536) sin reordenar. Las
+ * lecturas fuera de [0, 65535] se cuentan en el extremo más cercano.
  */
 class CircularBuffer {
 private:
     Nodo* cabeza;           // Puntero a la cabeza de la lista
     int capacidad;          // Capacidad máxima del buffer
     int tamano_actual;      // Número de elementos actuales
+    bool modo_anillo;       // Sobrescribir la más antigua al llenarse
+    ArbolFenwick* orden;    // Conteos por valor de la ventana (modo anillo)
+    
+    /**
+     * @brief Lleva un valor al dominio del árbol de Fenwick
+     * @param valor Lectura
+     * @return Valor recortado a [0, DOMINIO_ANILLO - 1]
+     */
+    static int recortar(int valor);
     
     /**
      * @brief Ordena los datos del buffer usando Insertion Sort
@@ -48,11 +65,15 @@ private:
     void intercambiar(Nodo* a, Nodo* b);
     
 public:
+    // Valores con contador propio en modo anillo (16 bits)
+    static const int DOMINIO_ANILLO = 65536;
+    
     /**
      * @brief Constructor que inicializa el buffer con capacidad fija
      * @param cap Capacidad del buffer
+     * @param anillo true para sobrescribir la lectura más antigua al llenarse
      */
-    CircularBuffer(int cap);
+    CircularBuffer(int cap, bool anillo = false);
     
     /**
      * @brief Destructor que libera toda la memoria
@@ -63,6 +84,7 @@ public:
      * @brief Inserta un dato en el buffer
      * @param valor Valor a insertar
      * @return true si se insertó correctamente, false si está lleno
+     *         (en modo anillo siempre se inserta)
      */
     bool insertar(int valor);
     
@@ -84,8 +106,32 @@ public:
      */
     int getTamano() const { return tamano_actual; }
     
+    /**
+     * @brief Cuenta las lecturas de la ventana menores o iguales a un valor
+     * @param valor Valor a consultar
+     * @return Rango del valor (0 si no está en modo anillo)
+     */
+    int rango(int valor) const;
+    
+    /**
+     * @brief Calcula un percentil de la ventana por rango más cercano
+     * @param p Percentil entre 0 y 100
+     * @return Valor del percentil (0 si está vacío o no está en modo anillo)
+     */
+    int percentil(double p) const;
+    
+    /**
+     * @brief Obtiene la mediana de la ventana
+     * @return Percentil 50
+     */
+    int mediana() const { return percentil(50); }
+    
     /**
      * @brief Ordena el buffer y escribe su contenido en un archivo
+     * 
+     * En modo anillo se ordena una copia de los valores (incluidos los que
+     * el árbol recorta), sin alterar el orden de llegada de la lista.
+     * 
      * @param nombre_archivo Nombre del archivo donde escribir
      * @return true si se escribió correctamente
      */
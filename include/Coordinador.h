@@ -0,0 +1,168 @@
+/**
+ * @file Coordinador.h
+ * @brief Ordenamiento particionado entre procesos worker locales
+ */
+
+#ifndef COORDINADOR_H
+#define COORDINADOR_H
+
+#include "DataSink.h"
+#include "Histograma.h"
+#include <sys/types.h>
+#include <cstdio>
+
+/**
+ * @class Coordinador
+ * @brief Reparte las lecturas por rangos entre P procesos worker
+ * 
+ * Las primeras TAMANO_MUESTRA lecturas se guardan y se ordenan para elegir
+ * P-1 divisores en sus cuantiles exactos. El reparto queda fijo desde ahí:
+ * si la entrada sigue ordenada o deriva más allá de ese prefijo, casi todo
+ * llega al primer o al último worker (el resultado es correcto, pero se
+ * pierde el paralelismo); getLecturasWorker() dice cuántas recibió cada uno.
+ * Luego se crean P procesos (fork) conectados por sockets Unix; cada uno
+ * recibe solo las lecturas de su rango y las ordena con su propio
+ * ExternalSorter (buffer circular, chunks y fusión) en una partición.
+ * Como los rangos no se solapan, el resultado final es la concatenación
+ * de las particiones en orden, sin otra fusión.
+ */
+class Coordinador : public DataSink {
+private:
+    int num_workers;            // P
+    int buffer_size;            // Buffer circular de cada worker
+    int rango_min;              // Rango declarado (modo conteo en workers)
+    int rango_max;
+    Histograma* resumen;        // Resumen en línea de todas las lecturas
+    char prefijo[64];           // Prefijo único de particiones y chunks
+    unsigned long long total;   // Lecturas recibidas
+    
+    int* muestra;               // Lecturas guardadas antes de repartir
+    int tam_muestra;            // Lecturas en la muestra
+    int* divisores;             // P-1 divisores ordenados
+    
+    bool repartiendo;           // Los workers ya están corriendo
+    bool terminado;             // finish() ya fue llamado
+    bool error;                 // Falló un envío o un worker
+    int* sockets;               // Extremo del coordinador de cada socket
+    pid_t* pids;                // Proceso de cada worker
+    int** envios;               // Lecturas pendientes de enviar por worker
+    int* envios_len;            // Lecturas en cada buffer de envío
+    unsigned long long* enviadas;  // Lecturas repartidas a cada worker
+    
+    /**
+     * @brief Genera el nombre de la partición de un worker
+     * @param nombre Buffer donde escribir (al menos 96 bytes)
+     * @param worker Índice del worker
+     */
+    void nombreParticion(char* nombre, int worker) const;
+    
+    /**
+     * @brief Ordena la muestra, elige los divisores y crea los workers
+     */
+    void iniciarWorkers();
+    
+    /**
+     * @brief Busca el worker cuyo rango contiene un valor
+     * @param valor Lectura
+     * @return Índice del worker
+     */
+    int elegirWorker(int valor) const;
+    
+    /**
+     * @brief Agrega una lectura al buffer de envío de su worker
+     * @param valor Lectura
+     */
+    void enviar(int valor);
+    
+    /**
+     * @brief Envía por el socket todo el buffer de un worker
+     * @param worker Índice del worker
+     */
+    void vaciarEnvio(int worker);
+    
+    /**
+     * @brief Cierra los sockets y espera a que terminen los workers
+     * @return true si todos los workers terminaron sin error
+     */
+    bool esperarWorkers();
+    
+public:
+    // Lecturas del prefijo usado para elegir los divisores (256 KiB)
+    static const int TAMANO_MUESTRA = 65536;
+    
+    // Lecturas acumuladas por worker antes de enviarlas
+    static const int TAMANO_ENVIO = 1024;
+    
+    /**
+     * @brief Constructor
+     * @param workers Número de procesos worker (P)
+     * @param buffer_size Capacidad del buffer circular de cada worker
+     * @param rango_min Menor valor esperado (por defecto 0)
+     * @param rango_max Mayor valor esperado (por defecto 65535)
+     */
+    Coordinador(int workers, int buffer_size, int rango_min = 0, int rango_max = 65535);
+    
+    /**
+     * @brief Destructor que detiene los workers y elimina las particiones
+     */
+    ~Coordinador();
+    
+    Coordinador(const Coordinador&) = delete;
+    Coordinador& operator=(const Coordinador&) = delete;
+    
+    /**
+     * @brief Agrega una lectura (a la muestra o al worker de su rango)
+     * @param valor Lectura a ordenar
+     * @return false si ya se llamó a finish() o falló un envío
+     */
+    bool push(int valor);
+    
+    /**
+     * @brief Cierra la entrada de los workers y espera sus particiones
+     * @return false si algún worker falló
+     */
+    bool finish();
+    
+    /**
+     * @brief Escribe la concatenación de las particiones en un archivo
+     * @param nombre_archivo Nombre del archivo de salida
+     * @return true si se escribió correctamente
+     */
+    bool escribir(const char* nombre_archivo);
+    
+    /**
+     * @brief Escribe la concatenación de las particiones en un flujo
+     * @param salida Flujo de salida; no se cierra
+     * @return true si se escribió correctamente
+     */
+    bool escribir(FILE* salida);
+    
+    /**
+     * @brief Obtiene el resumen en línea de las lecturas
+     * @return Histograma con min/max y percentiles
+     */
+    const Histograma& getResumen() const { return *resumen; }
+    
+    /**
+     * @brief Obtiene el número de lecturas recibidas
+     * @return Total de lecturas
+     */
+    unsigned long long getTotal() const { return total; }
+    
+    /**
+     * @brief Obtiene el número de procesos worker
+     * @return P
+     */
+    int getNumWorkers() const { return num_workers; }
+    
+    /**
+     * @brief Obtiene cuántas lecturas se repartieron a un worker
+     * @param worker Índice del worker
+     * @return Lecturas enviadas (0 si aún no se reparte)
+     */
+    unsigned long long getLecturasWorker(int worker) const {
+        return enviadas != nullptr ? enviadas[worker] : 0;
+    }
+};
+
+#endif // COORDINADOR_H
@@ -0,0 +1,67 @@
+/**
+ * @file DataSink.h
+ * @brief Clase base abstracta para destinos que ordenan datos
+ * 
+ * Contraparte de DataSource: recibe lecturas una a una y, al terminar,
+ * entrega el resultado ordenado. La implementan el ordenamiento en un
+ * proceso (ExternalSorter) y el particionado entre procesos (Coordinador).
+ */
+
+#ifndef DATASINK_H
+#define DATASINK_H
+
+#include "Histograma.h"
+#include <cstdio>
+
+/**
+ * @class DataSink
+ * @brief Clase abstracta que representa un destino de ordenamiento
+ */
+class DataSink {
+public:
+    /**
+     * @brief Destructor virtual para permitir polimorfismo
+     */
+    virtual ~DataSink() {}
+    
+    /**
+     * @brief Agrega una lectura
+     * @param valor Lectura a ordenar
+     * @return false si ya se llamó a finish() o hubo un error
+     */
+    virtual bool push(int valor) = 0;
+    
+    /**
+     * @brief Termina la entrada
+     * @return false si hubo un error al preparar el resultado
+     */
+    virtual bool finish() = 0;
+    
+    /**
+     * @brief Escribe el resultado ordenado en un archivo, uno por línea
+     * @param nombre_archivo Nombre del archivo de salida
+     * @return true si se escribió correctamente
+     */
+    virtual bool escribir(const char* nombre_archivo) = 0;
+    
+    /**
+     * @brief Escribe el resultado ordenado en un flujo abierto
+     * @param salida Flujo de salida; no se cierra
+     * @return true si se escribió correctamente
+     */
+    virtual bool escribir(FILE* salida) = 0;
+    
+    /**
+     * @brief Obtiene el resumen en línea de las lecturas
+     * @return Histograma con min/max y percentiles
+     */
+    virtual const Histograma& getResumen() const = 0;
+    
+    /**
+     * @brief Obtiene el número de lecturas recibidas
+     * @return Total de lecturas
+     */
+    virtual unsigned long long getTotal() const = 0;
+};
+
+#endif // DATASINK_H
@@ -0,0 +1,322 @@
+/**
+ * @file ExternalSorter.h
+ * @brief Ordenamiento externo embebible con API de empuje/extracción
+ */
+
+#ifndef EXTERNALSORTER_H
+#define EXTERNALSORTER_H
+
+#include "DataSource.h"
+#include "DataSink.h"
+#include "CircularBuffer.h"
+#include "Histograma.h"
+#include <cstdio>
+
+/**
+ * @class ExternalSorter
+ * @brief Ordena un flujo arbitrario de enteros con memoria acotada
+ * 
+ * Las lecturas se empujan con push() o pushAll(); al llamar a finish()
+ * el resultado ordenado se extrae con un iterador de una sola pasada, como
+ * DataSource con getResultado() o se escribe con escribir(). La fusión
+ * final es perezosa: cada valor se calcula cuando se pide. Si el rango
+ * declarado cabe en el presupuesto de contadores se ordena por conteo;
+ * ante la primera lectura fuera de rango se pasa a generar chunks con el
+ * CircularBuffer y fusionarlos al final.
+ * Los chunks son temporales y se eliminan en el destructor.
+ * 
+ * De cada chunk se guarda su mínimo y máximo. Al terminar, los chunks se
+ * agrupan por rangos que se solapan: solo dentro de cada grupo se fusiona,
+ * y un chunk que no se solapa con ningún otro se copia tal cual.
+ */
+class ExternalSorter : public DataSink {
+public:
+    /**
+     * @class iterator
+     * @brief Iterador de entrada sobre el resultado ordenado
+     */
+    class iterator {
+    private:
+        ExternalSorter* sorter;   // nullptr en el iterador final
+        int valor;                // Valor actual
+        
+    public:
+        /**
+         * @brief Constructor; con un sorter extrae el primer valor
+         * @param s Sorter del que extraer (nullptr para el final)
+         */
+        iterator(ExternalSorter* s) : sorter(s), valor(0) {
+            if (sorter != nullptr && !sorter->siguiente(valor)) {
+                sorter = nullptr;
+            }
+        }
+        
+        int operator*() const { return valor; }
+        
+        iterator& operator++() {
+            if (sorter != nullptr && !sorter->siguiente(valor)) {
+                sorter = nullptr;
+            }
+            return *this;
+        }
+        
+        bool operator==(const iterator& otro) const { return sorter == otro.sorter; }
+        bool operator!=(const iterator& otro) const { return sorter != otro.sorter; }
+    };
+    
+    /**
+     * @class Resultado
+     * @brief DataSource sobre el resultado ordenado del sorter
+     */
+    class Resultado : public DataSource {
+    private:
+        ExternalSorter* sorter;   // Sorter del que se extrae
+        bool has_next;            // Hay un valor pre-leído
+        int next_value;           // Valor pre-leído
+        
+    public:
+        /**
+         * @brief Constructor que pre-lee el primer valor
+         * @param s Sorter ya terminado
+         */
+        Resultado(ExternalSorter* s);
+        
+        int getNext();
+        bool hasMoreData() { return has_next; }
+    };
+    
+    // Presupuesto de contadores para el modo conteo (8 MiB)
+    static const long long MAX_CONTADORES = 1 << 20;
+    
+private:
+    CircularBuffer buffer;      // Buffer para generar chunks
+    Histograma* resumen;        // Resumen en línea y contadores del modo conteo
+    bool modo_conteo;           // Todas las lecturas cupieron en los contadores
+    char prefijo[64];           // Prefijo de los archivos temporales
+    int num_chunks;             // Chunks generados
+    unsigned long long total;   // Lecturas recibidas
+    bool terminado;             // finish() ya fue llamado
+    bool cambio_a_chunks;       // Se dejó el modo conteo durante la captura
+    int lectura_cambio;         // Lectura fuera de rango que causó el cambio
+    
+    int* chunk_min;             // Menor valor de cada chunk
+    int* chunk_max;             // Mayor valor de cada chunk
+    int capacidad_chunks;       // Tamaño reservado de chunk_min/chunk_max
+    int buffer_min;             // Menor valor en el buffer actual
+    int buffer_max;             // Mayor valor en el buffer actual
+    
+    int* orden;                 // Chunks ordenados por su mínimo
+    int* grupos;                // Inicio de cada grupo en orden (+ fin)
+    int num_grupos;             // Grupos de chunks que se solapan
+    int chunks_copiados;        // Grupos de un solo chunk (sin fusión)
+    int grupo_actual;           // Grupo que se está extrayendo
+    DataSource* fuente_actual;  // Chunk o fusión del grupo actual
+    bool error_fusion;          // No se pudo abrir algún chunk
+    Resultado* resultado;       // Vista DataSource del resultado
+    int valor_conteo;           // Valor actual al extraer desde los conteos
+    unsigned long long restantes_conteo;  // Repeticiones pendientes de ese valor
+    
+    /**
+     * @brief Genera el nombre de un chunk a partir del prefijo
+     * @param nombre Buffer donde escribir (al menos 96 bytes)
+     * @param numero Número de chunk
+     */
+    void nombreChunk(char* nombre, int numero) const;
+    
+    /**
+     * @brief Ordena el buffer y lo vuelca como un nuevo chunk
+     */
+    void volcarBuffer();
+    
+    /**
+     * @brief Guarda el rango del chunk recién escrito
+     * @param minimo Menor valor del chunk
+     * @param maximo Mayor valor del chunk
+     */
+    void registrarChunk(int minimo, int maximo);
+    
+    /**
+     * @brief Ordena los chunks por su mínimo y forma los grupos que se solapan
+     */
+    void agruparChunks();
+    
+    /**
+     * @brief Abre un grupo: el chunk mismo o la fusión de sus chunks
+     * @param g Índice del grupo
+     * @return Fuente del grupo, o nullptr si no se pudo abrir un chunk
+     */
+    DataSource* abrirGrupo(int g);
+    
+    /**
+     * @brief Extrae el siguiente valor ordenado
+     * @param valor Donde guardar el valor
+     * @return false si ya no quedan valores
+     */
+    bool siguiente(int& valor);
+    
+    /**
+     * @brief Cierra el grupo abierto y libera el estado de la fusión
+     */
+    void cerrarFusion();
+    
+public:
+    /**
+     * @brief Constructor
+     * @param buffer_size Capacidad del buffer circular (lecturas por chunk)
+     * @param rango_min Menor valor esperado (por defecto 0)
+     * @param rango_max Mayor valor esperado (por defecto 65535)
+     * @param prefijo_chunks Prefijo de los archivos temporales (por defecto
+     *        uno único por instancia, ver prefijoUnico())
+     */
+    ExternalSorter(int buffer_size, int rango_min = 0, int rango_max = 65535,
+                   const char* prefijo_chunks = nullptr);
+    
+    /**
+     * @brief Destructor que cierra y elimina los chunks
+     */
+    ~ExternalSorter();
+    
+    /**
+     * @brief Copia un archivo completo a un descriptor sin interpretarlo
+     * 
+     * Usa copy_file_range/sendfile en Linux y read/write en otro caso.
+     * 
+     * @param nombre Archivo de origen
+     * @param destino Descriptor de salida
+     * @return true si se copió completo
+     */
+    static bool copiarArchivo(const char* nombre, int destino);
+    
+    /**
+     * @brief Genera un prefijo de archivos temporales único
+     * 
+     * Combina el PID con un contador por instancia (base_PID_N), de modo que
+     * ni dos procesos ni dos objetos del mismo proceso compartan archivos.
+     * 
+     * @param destino Buffer donde escribir
+     * @param tamano Tamaño de destino
+     * @param base Inicio del prefijo
+     */
+    static void prefijoUnico(char* destino, int tamano, const char* base);
+    
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+    
+    /**
+     * @brief Agrega una lectura
+     * @param valor Lectura a ordenar
+     * @return false si ya se llamó a finish()
+     */
+    bool push(int valor);
+    
+    /**
+     * @brief Agrega un bloque de lecturas
+     * @param datos Lecturas a ordenar
+     * @param n Número de lecturas
+     * @return Número de lecturas agregadas
+     */
+    int push(const int* datos, int n);
+    
+    /**
+     * @brief Agrega todas las lecturas de una fuente hasta agotarla
+     * @param fuente Fuente de datos
+     * @return Número de lecturas agregadas
+     */
+    int pushAll(DataSource* fuente);
+    
+    /**
+     * @brief Termina la entrada y prepara la fusión
+     * @return false si no se pudo abrir algún chunk
+     */
+    bool finish();
+    
+    /**
+     * @brief Inicio del resultado ordenado (llama a finish() si hace falta)
+     * @return Iterador al primer valor
+     */
+    iterator begin();
+    
+    /**
+     * @brief Fin del resultado ordenado
+     * @return Iterador final
+     */
+    iterator end() { return iterator(nullptr); }
+    
+    /**
+     * @brief Obtiene el resultado como fuente de datos (llama a finish())
+     * 
+     * Comparte la posición con el iterador: el resultado se recorre una
+     * sola vez. El sorter conserva la propiedad de la fuente.
+     * 
+     * @return Fuente con los valores ordenados, o nullptr si falló finish()
+     */
+    DataSource* getResultado();
+    
+    /**
+     * @brief Escribe el resultado ordenado en un archivo, uno por línea
+     * @param nombre_archivo Nombre del archivo de salida
+     * @return true si se escribió correctamente
+     */
+    bool escribir(const char* nombre_archivo);
+    
+    /**
+     * @brief Escribe el resultado ordenado en un flujo abierto (archivo,
+     *        tubería o socket), uno por línea
+     * 
+     * Los chunks que no se solapan se copian al descriptor del flujo sin
+     * leerlos (copy_file_range/sendfile en Linux).
+     * @param salida Flujo de salida; no se cierra
+     * @return true si se escribió correctamente
+     */
+    bool escribir(FILE* salida);
+    
+    /**
+     * @brief Obtiene el resumen en línea de las lecturas
+     * @return Histograma con min/max y percentiles
+     */
+    const Histograma& getResumen() const { return *resumen; }
+    
+    /**
+     * @brief Obtiene el número de chunks generados
+     * @return Chunks en disco (0 en modo conteo)
+     */
+    int getNumChunks() const { return num_chunks; }
+    
+    /**
+     * @brief Obtiene el número de lecturas recibidas
+     * @return Total de lecturas
+     */
+    unsigned long long getTotal() const { return total; }
+    
+    /**
+     * @brief Verifica si se está ordenando por conteo
+     * @return true si no se generan chunks
+     */
+    bool enModoConteo() const { return modo_conteo; }
+    
+    /**
+     * @brief Verifica si una lectura fuera de rango obligó a dejar el modo conteo
+     * @return true si se pasó de conteo a chunks durante la captura
+     */
+    bool cambioAChunks() const { return cambio_a_chunks; }
+    
+    /**
+     * @brief Obtiene la lectura que obligó a dejar el modo conteo
+     * @return Primera lectura fuera de rango (0 si no hubo cambio)
+     */
+    int getLecturaCambio() const { return lectura_cambio; }
+    
+    /**
+     * @brief Obtiene el número de grupos de chunks que se solapan
+     * @return Grupos formados en finish() (0 en modo conteo)
+     */
+    int getNumGrupos() const { return num_grupos; }
+    
+    /**
+     * @brief Obtiene el número de chunks que se copian sin fusionar
+     * @return Grupos de un solo chunk
+     */
+    int getChunksCopiados() const { return chunks_copiados; }
+};
+
+#endif // EXTERNALSORTER_H
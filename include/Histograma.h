@@ -0,0 +1,194 @@
+/**
+ * @file Histograma.h
+ * @brief Histograma exacto de lecturas para resúmenes en línea
+ */
+
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+#include <cstdio>
+
+/**
+ * @class Histograma
+ * @brief Cuenta cuántas veces aparece cada valor de un dominio acotado
+ * 
+ * Se alimenta durante la adquisición (una operación O(1) por lectura) y
+ * permite consultar mínimo, máximo y percentiles en cualquier momento sin
+ * esperar al ordenamiento externo.
+ * 
+ * Las lecturas fuera del dominio (por ejemplo, con un rango declarado
+ * demasiado amplio para contar cada valor) van a cubetas logarítmicas: los
+ * valores menores que 128 son exactos y el resto se agrupa en 64 cubetas
+ * por potencia de 2. Los percentiles que caen ahí se responden con el
+ * centro de la cubeta, con error relativo menor que 1%.
+ */
+class Histograma {
+private:
+    unsigned long long* conteos;    // Un contador por valor del dominio
+    int dominio_min;                // Menor valor con contador propio
+    int dominio_max;                // Mayor valor con contador propio
+    unsigned long long total;       // Lecturas registradas
+    unsigned long long debajo;      // Lecturas menores que dominio_min
+    unsigned long long encima;      // Lecturas mayores que dominio_max
+    int valor_min;                  // Menor lectura observada
+    int valor_max;                  // Mayor lectura observada
+    unsigned long long* aproximados;  // Cubetas logarítmicas (fuera del dominio)
+    
+    // Cubetas por signo: 128 exactas + 64 por cada potencia 2^7..2^31
+    static const int CUBETAS_MAGNITUD = 128 + 25 * 64;
+    
+    /**
+     * @brief Calcula la cubeta logarítmica de un valor
+     * @param valor Lectura
+     * @return Índice en aproximados, en el mismo orden que los valores
+     */
+    static int cubeta(int valor);
+    
+    /**
+     * @brief Obtiene el valor representativo (centro) de una cubeta
+     * @param indice Índice en aproximados
+     * @return Centro del intervalo de la cubeta
+     */
+    static long long centroCubeta(int indice);
+    
+    /**
+     * @brief Busca la lectura número k entre las de fuera del dominio
+     * @param k Posición (1 a debajo + encima)
+     * @return Centro de la cubeta, acotado al mínimo/máximo observado
+     */
+    int buscarAproximado(unsigned long long k) const;
+    
+public:
+    /**
+     * @brief Constructor que reserva un contador por valor del dominio
+     * @param min_dominio Menor valor del dominio (por defecto 0)
+     * @param max_dominio Mayor valor del dominio (por defecto 65535, 16 bits)
+     */
+    Histograma(int min_dominio = 0, int max_dominio = 65535);
+    
+    /**
+     * @brief Destructor que libera los contadores
+     */
+    ~Histograma();
+    
+    Histograma(const Histograma&) = delete;
+    Histograma& operator=(const Histograma&) = delete;
+    
+    /**
+     * @brief Registra una lectura
+     * @param valor Lectura recibida
+     */
+    void agregar(int valor);
+    
+    /**
+     * @brief Obtiene el número de lecturas registradas
+     * @return Total de lecturas
+     */
+    unsigned long long getTotal() const { return total; }
+    
+    /**
+     * @brief Obtiene el número de lecturas fuera del dominio
+     * @return Lecturas por debajo o por encima del dominio
+     */
+    unsigned long long getFueraDeRango() const { return debajo + encima; }
+    
+    /**
+     * @brief Verifica si un valor tiene contador propio
+     * @param valor Valor a verificar
+     * @return true si está dentro del dominio
+     */
+    bool enDominio(int valor) const { return valor >= dominio_min && valor <= dominio_max; }
+    
+    /**
+     * @brief Obtiene cuántas veces apareció un valor del dominio
+     * @param valor Valor a consultar
+     * @return Conteo del valor (0 si está fuera del dominio)
+     */
+    unsigned long long getConteo(int valor) const {
+        return enDominio(valor) ? conteos[valor - dominio_min] : 0;
+    }
+    
+    /**
+     * @brief Obtiene el menor valor del dominio
+     * @return Límite inferior del dominio
+     */
+    int getDominioMin() const { return dominio_min; }
+    
+    /**
+     * @brief Obtiene el mayor valor del dominio
+     * @return Límite superior del dominio
+     */
+    int getDominioMax() const { return dominio_max; }
+    
+    /**
+     * @brief Obtiene la menor lectura observada
+     * @return Mínimo (0 si no hay lecturas)
+     */
+    int getMinimo() const { return valor_min; }
+    
+    /**
+     * @brief Obtiene la mayor lectura observada
+     * @return Máximo (0 si no hay lecturas)
+     */
+    int getMaximo() const { return valor_max; }
+    
+    /**
+     * @brief Calcula un percentil por rango más cercano
+     * @param p Percentil entre 0 y 100
+     * @return Valor del percentil (0 si no hay lecturas)
+     */
+    int percentil(double p) const;
+    
+    /**
+     * @brief Posición de un percentil por rango más cercano
+     * @param p Percentil entre 0 y 100
+     * @param total Número de lecturas (mayor que 0)
+     * @return ceil(p/100 * total), acotado a [1, total]
+     */
+    static unsigned long long rangoPercentil(double p, unsigned long long total);
+    
+    /**
+     * @brief Guarda el resumen y los contenedores no vacíos en un archivo
+     * @param nombre_archivo Nombre del archivo donde escribir
+     * @return true si se escribió correctamente
+     */
+    bool guardar(const char* nombre_archivo) const;
+    
+    /**
+     * @brief Escribe en orden las lecturas del dominio, una por línea
+     * 
+     * Cada valor se formatea una sola vez y se repite tantas veces como
+     * indique su contador. Las lecturas fuera del dominio no se escriben.
+     * 
+     * @param nombre_archivo Nombre del archivo donde escribir
+     * @return true si se escribió correctamente
+     */
+    bool escribirOrdenado(const char* nombre_archivo) const;
+    
+    /**
+     * @brief Escribe en orden las lecturas del dominio en un flujo abierto
+     * @param salida Flujo de salida; no se cierra
+     * @return true si se escribió correctamente
+     */
+    bool escribirOrdenado(FILE* salida) const;
+    
+    /**
+     * @brief Escribe en orden las lecturas del dominio a partir de un valor
+     * 
+     * Permite continuar una extracción parcial: primero se escriben las
+     * repeticiones pendientes de desde y luego todos los valores mayores.
+     * 
+     * @param salida Flujo de salida; no se cierra
+     * @param desde Valor del dominio donde continuar
+     * @param pendientes Repeticiones de desde que faltan por escribir
+     * @return true si se escribió correctamente
+     */
+    bool escribirOrdenado(FILE* salida, int desde, unsigned long long pendientes) const;
+    
+    /**
+     * @brief Muestra mínimo, máximo y percentiles principales
+     */
+    void mostrar() const;
+};
+
+#endif // HISTOGRAMA_H
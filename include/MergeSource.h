@@ -0,0 +1,53 @@
+/**
+ * @file MergeSource.h
+ * @brief DataSource que fusiona fuentes ordenadas bajo demanda
+ */
+
+#ifndef MERGESOURCE_H
+#define MERGESOURCE_H
+
+#include "DataSource.h"
+
+/**
+ * @class MergeSource
+ * @brief K-Way Merge perezoso sobre K fuentes ordenadas
+ * 
+ * Cada getNext() entrega el mínimo entre los valores actuales de las
+ * fuentes y avanza solo la fuente de la que salió, así el consumidor
+ * recibe el resultado a medida que se produce, sin archivo intermedio.
+ */
+class MergeSource : public DataSource {
+private:
+    DataSource** fuentes;   // Fuentes ordenadas (propiedad de MergeSource)
+    int num_fuentes;        // K
+    int* valores;           // Valor actual de cada fuente
+    bool* activos;          // La fuente aún tiene un valor actual
+    int num_activos;        // Fuentes con valor actual
+    
+public:
+    /**
+     * @brief Constructor que toma posesión de las fuentes
+     * @param srcs Arreglo de K fuentes ordenadas (creado con new[])
+     * @param n Número de fuentes
+     */
+    MergeSource(DataSource** srcs, int n);
+    
+    /**
+     * @brief Destructor que libera las fuentes
+     */
+    ~MergeSource();
+    
+    /**
+     * @brief Obtiene el siguiente valor de la fusión
+     * @return Menor valor pendiente entre todas las fuentes
+     */
+    int getNext();
+    
+    /**
+     * @brief Verifica si quedan valores en alguna fuente
+     * @return true si hay más datos
+     */
+    bool hasMoreData();
+};
+
+#endif // MERGESOURCE_H
@@ -0,0 +1,28 @@
+/**
+ * @file Ordenamiento.h
+ * @brief Merge Sort de arreglos de enteros
+ * 
+ * Ordenamiento O(n log n) y estable para los arreglos auxiliares que crecen
+ * con la entrada (chunks, muestras, ventanas), donde un Insertion Sort
+ * degenera a O(n²) con datos en orden inverso.
+ */
+
+#ifndef ORDENAMIENTO_H
+#define ORDENAMIENTO_H
+
+/**
+ * @brief Ordena un arreglo de enteros de menor a mayor
+ * @param datos Arreglo a ordenar
+ * @param n Número de elementos
+ */
+void ordenarEnteros(int* datos, int n);
+
+/**
+ * @brief Ordena índices según el valor de una clave, de forma estable
+ * @param indices Índices a ordenar (posiciones válidas de claves)
+ * @param n Número de índices
+ * @param claves Clave de cada índice
+ */
+void ordenarPorClave(int* indices, int n, const int* claves);
+
+#endif // ORDENAMIENTO_H
@@ -0,0 +1,48 @@
+/**
+ * @file Protocolo.h
+ * @brief Tramas binarias entre el Arduino y SerialSource
+ * 
+ * Formato de una trama (enteros en little-endian):
+ * 
+ *   A5 5A | secuencia (4) | n (1) | n lecturas (2 c/u) | CRC-16 (2)
+ * 
+ * La secuencia es el índice de la primera lectura de la trama, de modo
+ * que un salto en la secuencia indica exactamente cuántas lecturas se
+ * perdieron. El CRC-16/CCITT (0x1021, inicial 0xFFFF) cubre desde la
+ * secuencia hasta la última lectura.
+ * 
+ * SerialSource da el puerto por desconectado tras 1 s sin datos, así que
+ * el emisor envía una trama parcial si pasan TRAMA_MAX_ESPERA_MS sin
+ * completar una llena.
+ */
+
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+const unsigned char TRAMA_SYNC_0 = 0xA5;        // Primer byte de sincronía
+const unsigned char TRAMA_SYNC_1 = 0x5A;        // Segundo byte de sincronía
+const int TRAMA_CABECERA = 7;                   // Sync + secuencia + n
+const int TRAMA_MAX_LECTURAS = 32;              // Lecturas por trama
+const int TRAMA_MAX_BYTES = TRAMA_CABECERA + 2 * TRAMA_MAX_LECTURAS + 2;
+const int TRAMA_MAX_ESPERA_MS = 400;            // Espera máxima entre tramas
+
+/**
+ * @brief Calcula el CRC-16/CCITT de un bloque de bytes
+ * @param datos Bytes a procesar
+ * @param largo Número de bytes
+ * @return CRC del bloque
+ */
+unsigned short calcularCrc16(const unsigned char* datos, int largo);
+
+/**
+ * @brief Arma una trama con un lote de lecturas
+ * @param destino Buffer de al menos TRAMA_MAX_BYTES bytes
+ * @param secuencia Índice de la primera lectura del lote
+ * @param lecturas Lecturas de 16 bits
+ * @param n Número de lecturas (1 a TRAMA_MAX_LECTURAS)
+ * @return Número de bytes escritos en destino
+ */
+int codificarTrama(unsigned char* destino, unsigned int secuencia,
+                   const unsigned short* lecturas, int n);
+
+#endif // PROTOCOLO_H
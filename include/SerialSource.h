@@ -7,19 +7,52 @@
 #define SERIALSOURCE_H
 
 #include "DataSource.h"
+#include "Protocolo.h"
 
 /**
  * @class SerialSource
  * @brief Lee datos enteros desde un puerto serial (Arduino)
+ * 
+ * Acepta tramas binarias (ver Protocolo.h) o líneas de texto; el formato
+ * se detecta con el primer byte reconocible que llega.
  */
 class SerialSource : public DataSource {
 private:
+    /**
+     * @brief Formato del flujo recibido
+     */
+    enum Protocolo {
+        PROTOCOLO_DESCONOCIDO,
+        PROTOCOLO_TEXTO,
+        PROTOCOLO_BINARIO
+    };
+    
     int fd;                    // File descriptor del puerto serial
-    char buffer[256];          // Buffer para lectura de líneas
-    int buffer_pos;            // Posición actual en el buffer
+    unsigned char buffer[256]; // Bytes recibidos aún no procesados
+    int buffer_inicio;         // Primer byte pendiente en el buffer
+    int buffer_fin;            // Fin de los bytes válidos en el buffer
     bool is_connected;         // Estado de conexión
     int max_readings;          // Número máximo de lecturas (0 = infinito)
     int readings_count;        // Contador de lecturas realizadas
+    bool has_pending;          // Hay una lectura pre-leída
+    int pending_value;         // Lectura pre-leída por hasMoreData()
+    Protocolo protocolo;       // Formato detectado
+    
+    int lote[TRAMA_MAX_LECTURAS];  // Lecturas de la última trama
+    int lote_pos;                  // Siguiente lectura a entregar del lote
+    int lote_len;                  // Lecturas en el lote
+    bool hay_secuencia;            // Ya se recibió al menos una trama
+    unsigned int secuencia_esperada;  // Secuencia de la próxima trama
+    unsigned long long lecturas_perdidas;  // Huecos en la secuencia
+    int tramas_invalidas;          // Tramas descartadas por CRC o tamaño
+    unsigned long long bytes_descartados;  // Bytes saltados al resincronizar
+    
+    /**
+     * @brief Garantiza que haya al menos n bytes pendientes en el buffer
+     * @param n Bytes requeridos (máximo el tamaño del buffer)
+     * @return false si hubo timeout o error antes de completarlos
+     */
+    bool asegurarBytes(int n);
     
     /**
      * @brief Lee una línea completa del puerto serial
@@ -29,6 +62,25 @@ private:
      */
     bool readLine(char* line, int max_len);
     
+    /**
+     * @brief Busca la siguiente trama válida y carga sus lecturas en el lote
+     * @return true si se cargó una trama, false si hay error
+     */
+    bool leerTrama();
+    
+    /**
+     * @brief Lee la siguiente lectura del puerto
+     * @param valor Donde guardar la lectura
+     * @return false si hubo timeout o error (el puerto queda desconectado)
+     */
+    bool readValue(int& valor);
+    
+    /**
+     * @brief Determina el protocolo a partir de los primeros bytes
+     * @return false si no llegaron datos
+     */
+    bool detectarProtocolo();
+    
 public:
     /**
      * @brief Constructor que abre y configura el puerto serial
@@ -50,7 +102,11 @@ public:
     
     /**
      * @brief Verifica si hay más datos disponibles
-     * @return true si el puerto está conectado y no se alcanzó el límite
+     * 
+     * Pre-lee la siguiente lectura (esperando hasta el timeout del puerto),
+     * así getNext() siempre devuelve un dato real.
+     * 
+     * @return true si hay una lectura disponible y no se alcanzó el límite
      */
     bool hasMoreData();
     
@@ -59,6 +115,23 @@ public:
      * @return true si está conectado
      */
     bool isConnected() const { return is_connected; }
+    
+    /**
+     * @brief Obtiene las lecturas perdidas según la secuencia de las tramas
+     * @return Lecturas que no llegaron (0 en modo texto)
+     */
+    unsigned long long getLecturasPerdidas() const { return lecturas_perdidas; }
+    
+    /**
+     * @brief Obtiene las tramas descartadas por CRC o tamaño inválido
+     * @return Número de tramas descartadas
+     */
+    int getTramasInvalidas() const { return tramas_invalidas; }
+    
+    /**
+     * @brief Muestra el protocolo detectado y los contadores de errores
+     */
+    void mostrarEstadisticas() const;
 };
 
 #endif // SERIALSOURCE_H
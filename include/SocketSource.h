@@ -0,0 +1,57 @@
+/**
+ * @file SocketSource.h
+ * @brief Implementación de DataSource para sockets y tuberías
+ */
+
+#ifndef SOCKETSOURCE_H
+#define SOCKETSOURCE_H
+
+#include "DataSource.h"
+
+/**
+ * @class SocketSource
+ * @brief Lee enteros binarios (int nativo) desde un descriptor
+ * 
+ * Pensado para sockets Unix entre procesos del mismo equipo, por lo que
+ * no convierte el orden de bytes.
+ */
+class SocketSource : public DataSource {
+private:
+    int fd;                 // Descriptor del socket
+    int buffer[1024];       // Enteros recibidos
+    int buffer_pos;         // Siguiente entero a entregar
+    int buffer_len;         // Enteros válidos en el buffer
+    int bytes_parciales;    // Bytes de un entero incompleto al final
+    
+    /**
+     * @brief Recibe más enteros cuando el buffer se agota
+     * @return false si el otro extremo cerró la conexión
+     */
+    bool recibir();
+    
+public:
+    /**
+     * @brief Constructor que toma posesión del descriptor
+     * @param descriptor Socket ya conectado
+     */
+    SocketSource(int descriptor);
+    
+    /**
+     * @brief Destructor que cierra el descriptor
+     */
+    ~SocketSource();
+    
+    /**
+     * @brief Obtiene el siguiente entero del socket
+     * @return Entero recibido
+     */
+    int getNext();
+    
+    /**
+     * @brief Verifica si hay más datos (espera si el buffer está vacío)
+     * @return true mientras el otro extremo no cierre la conexión
+     */
+    bool hasMoreData();
+};
+
+#endif // SOCKETSOURCE_H
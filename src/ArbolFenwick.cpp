@@ -0,0 +1,58 @@
+/**
+ * @file ArbolFenwick.cpp
+ * @brief Implementación de la clase ArbolFenwick
+ */
+
+#include "ArbolFenwick.h"
+
+ArbolFenwick::ArbolFenwick(int n)
+    : arbol(nullptr), tamano(n), mayor_potencia(1) {
+    
+    arbol = new int[tamano + 1]();
+    
+    while (mayor_potencia * 2 <= tamano) {
+        mayor_potencia *= 2;
+    }
+}
+
+ArbolFenwick::~ArbolFenwick() {
+    delete[] arbol;
+}
+
+void ArbolFenwick::actualizar(int valor, int delta) {
+    for (int i = valor + 1; i <= tamano; i += i & (-i)) {
+        arbol[i] += delta;
+    }
+}
+
+int ArbolFenwick::prefijo(int valor) const {
+    if (valor >= tamano) {
+        valor = tamano - 1;
+    }
+    
+    int suma = 0;
+    for (int i = valor + 1; i > 0; i -= i & (-i)) {
+        suma += arbol[i];
+    }
+    return suma;
+}
+
+int ArbolFenwick::buscarKesimo(int k) const {
+    // Descender por potencias de 2 sin pasar de k lecturas acumuladas
+    int pos = 0;
+    for (int paso = mayor_potencia; paso > 0; paso /= 2) {
+        if (pos + paso <= tamano && arbol[pos + paso] < k) {
+            pos += paso;
+            k -= arbol[pos];
+        }
+    }
+    
+    // pos es el último índice con suma < k; el valor es el siguiente
+    return pos;
+}
+
+void ArbolFenwick::limpiar() {
+    for (int i = 0; i <= tamano; i++) {
+        arbol[i] = 0;
+    }
+}
@@ -4,19 +4,51 @@
  */
 
 #include "CircularBuffer.h"
+#include "Histograma.h"
+#include "Ordenamiento.h"
 #include <cstdio>
 
-CircularBuffer::CircularBuffer(int cap) 
-    : cabeza(nullptr), capacidad(cap), tamano_actual(0) {
+CircularBuffer::CircularBuffer(int cap, bool anillo) 
+    : cabeza(nullptr), capacidad(cap), tamano_actual(0),
+      modo_anillo(anillo), orden(nullptr) {
+    
+    if (modo_anillo) {
+        orden = new ArbolFenwick(DOMINIO_ANILLO);
+    }
 }
 
 CircularBuffer::~CircularBuffer() {
     vaciar();
+    delete orden;
+}
+
+int CircularBuffer::recortar(int valor) {
+    if (valor < 0) {
+        return 0;
+    }
+    if (valor >= DOMINIO_ANILLO) {
+        return DOMINIO_ANILLO - 1;
+    }
+    return valor;
 }
 
 bool CircularBuffer::insertar(int valor) {
     if (estaLleno()) {
-        return false;
+        if (!modo_anillo || cabeza == nullptr) {
+            return false;
+        }
+        
+        // La cabeza es la lectura más antigua: se sobrescribe y pasa a
+        // ser la cola, sin crear ni liberar nodos
+        orden->actualizar(recortar(cabeza->dato), -1);
+        cabeza->dato = valor;
+        cabeza = cabeza->siguiente;
+        orden->actualizar(recortar(valor), 1);
+        return true;
+    }
+    
+    if (modo_anillo) {
+        orden->actualizar(recortar(valor), 1);
     }
     
     Nodo* nuevo = new Nodo(valor);
@@ -72,29 +104,61 @@ void CircularBuffer::ordenarInternamente() {
     }
 }
 
+int CircularBuffer::rango(int valor) const {
+    if (!modo_anillo || valor < 0) {
+        return 0;
+    }
+    return orden->prefijo(recortar(valor));
+}
+
+int CircularBuffer::percentil(double p) const {
+    if (!modo_anillo || tamano_actual == 0) {
+        return 0;
+    }
+    
+    return orden->buscarKesimo((int)Histograma::rangoPercentil(p, tamano_actual));
+}
+
 bool CircularBuffer::ordenarYVolcar(const char* nombre_archivo) {
     if (estaVacio()) {
         return false;
     }
     
-    // Ordenar el contenido
-    ordenarInternamente();
+    // En modo anillo el orden de llegada se conserva
+    if (!modo_anillo) {
+        ordenarInternamente();
+    }
     
     // Escribir al archivo
     FILE* archivo = fopen(nombre_archivo, "w");
     if (archivo == nullptr) {
-        printf("Error: No se pudo crear el archivo %s\n", nombre_archivo);
+        fprintf(stderr, "Error: No se pudo crear el archivo %s\n", nombre_archivo);
         return false;
     }
     
-    Nodo* actual = cabeza;
-    for (int i = 0; i < tamano_actual; i++) {
-        fprintf(archivo, "%d\n", actual->dato);
-        actual = actual->siguiente;
+    if (modo_anillo) {
+        // Copia de los valores reales: el árbol solo guarda valores recortados
+        int* valores = new int[tamano_actual];
+        Nodo* actual = cabeza;
+        for (int i = 0; i < tamano_actual; i++) {
+            valores[i] = actual->dato;
+            actual = actual->siguiente;
+        }
+        ordenarEnteros(valores, tamano_actual);
+        
+        for (int i = 0; i < tamano_actual; i++) {
+            fprintf(archivo, "%d\n", valores[i]);
+        }
+        delete[] valores;
+    } else {
+        Nodo* actual = cabeza;
+        for (int i = 0; i < tamano_actual; i++) {
+            fprintf(archivo, "%d\n", actual->dato);
+            actual = actual->siguiente;
+        }
     }
     
     fclose(archivo);
-    printf("Guardado: %s\n", nombre_archivo);
     
     return true;
 }
@@ -118,6 +182,10 @@ void CircularBuffer::vaciar() {
     
     cabeza = nullptr;
     tamano_actual = 0;
+    
+    if (orden != nullptr) {
+        orden->limpiar();
+    }
 }
 
 void CircularBuffer::mostrar() const {
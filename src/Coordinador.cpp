@@ -0,0 +1,346 @@
+/**
+ * @file Coordinador.cpp
+ * @brief Implementación de la clase Coordinador
+ */
+
+#include "Coordinador.h"
+#include "ExternalSorter.h"
+#include "SocketSource.h"
+#include "Ordenamiento.h"
+#include <cstdio>
+#include <unistd.h>     // Para fork(), close()
+#include <sys/socket.h> // Para socketpair(), send()
+#include <sys/wait.h>   // Para waitpid()
+#ifdef __linux__
+#include <dirent.h>     // Para recorrer /proc/self/fd
+#include <cstdlib>      // Para atoi()
+#endif
+
+// Un worker caído no debe matar con SIGPIPE al proceso que usa la biblioteca
+#ifdef MSG_NOSIGNAL
+const int SIN_SIGPIPE = MSG_NOSIGNAL;
+#else
+const int SIN_SIGPIPE = 0;     // Se usa SO_NOSIGPIPE en el socket
+#endif
+
+// Cierra en un worker todo descriptor heredado salvo stdio y su socket:
+// puerto serial, salida de datos y sockets de otros workers o coordinadores
+// (si quedaran abiertos, esos workers nunca verían el fin de sus datos)
+static void cerrarHeredados(int conservar) {
+#ifdef __linux__
+    DIR* dir = opendir("/proc/self/fd");
+    if (dir != nullptr) {
+        struct dirent* entrada;
+        while ((entrada = readdir(dir)) != nullptr) {
+            int fd = atoi(entrada->d_name);
+            if (fd > 2 && fd != conservar && fd != dirfd(dir)) {
+                close(fd);
+            }
+        }
+        closedir(dir);
+        return;
+    }
+#endif
+    long limite = sysconf(_SC_OPEN_MAX);
+    for (int fd = 3; fd < limite; fd++) {
+        if (fd != conservar) {
+            close(fd);
+        }
+    }
+}
+
+// Trabajo de un proceso worker: ordenar lo que llega por el socket
+static int ejecutarWorker(int fd, const char* prefijo, int id, int buffer_size,
+                          int rango_min, int rango_max, const char* particion) {
+    SocketSource fuente(fd);
+    
+    char prefijo_chunks[96];
+    snprintf(prefijo_chunks, sizeof(prefijo_chunks), "%s_w%d", prefijo, id);
+    ExternalSorter sorter(buffer_size, rango_min, rango_max, prefijo_chunks);
+    
+    sorter.pushAll(&fuente);
+    
+    return sorter.escribir(particion) ? 0 : 1;
+}
+
+Coordinador::Coordinador(int workers, int buffer_size, int rango_min, int rango_max)
+    : num_workers(workers), buffer_size(buffer_size), rango_min(rango_min),
+      rango_max(rango_max), resumen(nullptr), total(0), muestra(nullptr),
+      tam_muestra(0), divisores(nullptr), repartiendo(false), terminado(false),
+      error(false), sockets(nullptr), pids(nullptr), envios(nullptr),
+      envios_len(nullptr), enviadas(nullptr) {
+    
+    if (num_workers < 1) {
+        num_workers = 1;
+    }
+    
+    // El resumen usa el dominio de 16 bits si el rango no cabe en memoria
+    if ((long long)rango_max - rango_min + 1 > ExternalSorter::MAX_CONTADORES) {
+        resumen = new Histograma();
+    } else {
+        resumen = new Histograma(rango_min, rango_max);
+    }
+    
+    ExternalSorter::prefijoUnico(prefijo, sizeof(prefijo), "esort");
+    muestra = new int[TAMANO_MUESTRA];
+}
+
+Coordinador::~Coordinador() {
+    if (repartiendo && !terminado) {
+        esperarWorkers();
+    }
+    
+    if (repartiendo) {
+        for (int i = 0; i < num_workers; i++) {
+            char nombre[96];
+            nombreParticion(nombre, i);
+            remove(nombre);
+            delete[] envios[i];
+        }
+    }
+    
+    delete[] envios;
+    delete[] envios_len;
+    delete[] enviadas;
+    delete[] sockets;
+    delete[] pids;
+    delete[] divisores;
+    delete[] muestra;
+    delete resumen;
+}
+
+void Coordinador::nombreParticion(char* nombre, int worker) const {
+    sprintf(nombre, "%s_part_%d.tmp", prefijo, worker);
+}
+
+void Coordinador::iniciarWorkers() {
+    // Divisores en los cuantiles i/P de la muestra ordenada
+    ordenarEnteros(muestra, tam_muestra);
+    
+    divisores = new int[num_workers];
+    for (int i = 1; i < num_workers; i++) {
+        divisores[i - 1] = tam_muestra > 0 ? muestra[(long long)i * tam_muestra / num_workers] : 0;
+    }
+    
+    sockets = new int[num_workers];
+    pids = new pid_t[num_workers];
+    envios = new int*[num_workers];
+    envios_len = new int[num_workers];
+    enviadas = new unsigned long long[num_workers];
+    
+    // Evitar que los hijos hereden y repitan la salida pendiente
+    fflush(stdout);
+    
+    for (int i = 0; i < num_workers; i++) {
+        envios[i] = new int[TAMANO_ENVIO];
+        envios_len[i] = 0;
+        enviadas[i] = 0;
+        sockets[i] = -1;
+        pids[i] = -1;
+        
+        int par[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, par) != 0) {
+            fprintf(stderr, "Error: No se pudo crear el socket del worker %d\n", i);
+            error = true;
+            continue;
+        }
+        
+        pid_t pid = fork();
+        
+        if (pid == 0) {
+            // Worker: solo conserva su extremo del socket
+            cerrarHeredados(par[1]);
+            
+            char particion[96];
+            nombreParticion(particion, i);
+            int codigo = ejecutarWorker(par[1], prefijo, i, buffer_size,
+                                        rango_min, rango_max, particion);
+            fflush(stdout);
+            _exit(codigo);
+        }
+        
+        close(par[1]);
+        
+        if (pid < 0) {
+            fprintf(stderr, "Error: No se pudo crear el worker %d\n", i);
+            close(par[0]);
+            error = true;
+            continue;
+        }
+        
+#ifdef SO_NOSIGPIPE
+        int activo = 1;
+        setsockopt(par[0], SOL_SOCKET, SO_NOSIGPIPE, &activo, sizeof(activo));
+#endif
+        sockets[i] = par[0];
+        pids[i] = pid;
+    }
+    
+    repartiendo = true;
+    
+    // Repartir la muestra
+    for (int i = 0; i < tam_muestra; i++) {
+        enviar(muestra[i]);
+    }
+    tam_muestra = 0;
+}
+
+int Coordinador::elegirWorker(int valor) const {
+    // Primer divisor mayor que el valor (búsqueda binaria)
+    int izquierda = 0;
+    int derecha = num_workers - 1;
+    
+    while (izquierda < derecha) {
+        int medio = (izquierda + derecha) / 2;
+        if (divisores[medio] > valor) {
+            derecha = medio;
+        } else {
+            izquierda = medio + 1;
+        }
+    }
+    
+    return izquierda;
+}
+
+void Coordinador::enviar(int valor) {
+    int w = elegirWorker(valor);
+    enviadas[w]++;
+    
+    envios[w][envios_len[w]++] = valor;
+    if (envios_len[w] == TAMANO_ENVIO) {
+        vaciarEnvio(w);
+    }
+}
+
+void Coordinador::vaciarEnvio(int worker) {
+    const char* datos = (const char*)envios[worker];
+    int restantes = envios_len[worker] * sizeof(int);
+    envios_len[worker] = 0;
+    
+    if (sockets[worker] < 0) {
+        error = true;
+        return;
+    }
+    
+    while (restantes > 0) {
+        int n = send(sockets[worker], datos, restantes, SIN_SIGPIPE);
+        if (n <= 0) {
+            fprintf(stderr, "Error: El worker %d dejó de recibir datos\n", worker);
+            error = true;
+            return;
+        }
+        datos += n;
+        restantes -= n;
+    }
+}
+
+bool Coordinador::push(int valor) {
+    if (terminado || error) {
+        return false;
+    }
+    
+    resumen->agregar(valor);
+    total++;
+    
+    if (!repartiendo) {
+        muestra[tam_muestra++] = valor;
+        if (tam_muestra == TAMANO_MUESTRA) {
+            iniciarWorkers();
+        }
+        return !error;
+    }
+    
+    enviar(valor);
+    return !error;
+}
+
+bool Coordinador::esperarWorkers() {
+    bool ok = true;
+    
+    for (int i = 0; i < num_workers; i++) {
+        if (sockets[i] >= 0) {
+            close(sockets[i]);
+            sockets[i] = -1;
+        }
+    }
+    
+    for (int i = 0; i < num_workers; i++) {
+        if (pids[i] <= 0) {
+            ok = false;
+            continue;
+        }
+        
+        int estado = 0;
+        if (waitpid(pids[i], &estado, 0) < 0 ||
+            !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+            fprintf(stderr, "Error: El worker %d terminó con error\n", i);
+            ok = false;
+        }
+        pids[i] = -1;
+    }
+    
+    return ok;
+}
+
+bool Coordinador::finish() {
+    if (terminado) {
+        return !error;
+    }
+    
+    if (!repartiendo) {
+        iniciarWorkers();
+    }
+    terminado = true;
+    
+    for (int i = 0; i < num_workers; i++) {
+        if (envios_len[i] > 0) {
+            vaciarEnvio(i);
+        }
+    }
+    
+    // Al cerrar los sockets cada worker ve el fin de sus datos
+    if (!esperarWorkers()) {
+        error = true;
+    }
+    
+    return !error;
+}
+
+bool Coordinador::escribir(const char* nombre_archivo) {
+    if (!finish()) {
+        return false;
+    }
+    
+    FILE* salida = fopen(nombre_archivo, "w");
+    if (salida == nullptr) {
+        fprintf(stderr, "Error: No se pudo crear el archivo %s\n", nombre_archivo);
+        return false;
+    }
+    
+    bool ok = escribir(salida);
+    fclose(salida);
+    
+    return ok;
+}
+
+bool Coordinador::escribir(FILE* salida) {
+    if (!finish()) {
+        return false;
+    }
+    
+    if (fflush(salida) != 0) {
+        return false;
+    }
+    
+    // Las particiones no se solapan: basta con copiarlas en orden
+    for (int i = 0; i < num_workers; i++) {
+        char nombre[96];
+        nombreParticion(nombre, i);
+        if (!ExternalSorter::copiarArchivo(nombre, fileno(salida))) {
+            fprintf(stderr, "Error: No se pudo copiar %s\n", nombre);
+            return false;
+        }
+    }
+    
+    return true;
+}
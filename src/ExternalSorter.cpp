@@ -0,0 +1,443 @@
+/**
+ * @file ExternalSorter.cpp
+ * @brief Implementación de la clase ExternalSorter
+ */
+
+#include "ExternalSorter.h"
+#include "FileSource.h"
+#include "MergeSource.h"
+#include "Ordenamiento.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>      // Para open()
+#include <unistd.h>     // Para read(), write(), close()
+#include <sys/stat.h>   // Para fstat()
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+ExternalSorter::ExternalSorter(int buffer_size, int rango_min, int rango_max,
+                               const char* prefijo_chunks)
+    : buffer(buffer_size), resumen(nullptr), modo_conteo(true), num_chunks(0),
+      total(0), terminado(false), cambio_a_chunks(false), lectura_cambio(0),
+      chunk_min(nullptr), chunk_max(nullptr), capacidad_chunks(0),
+      buffer_min(0), buffer_max(0), orden(nullptr), grupos(nullptr),
+      num_grupos(0), chunks_copiados(0), grupo_actual(-1),
+      fuente_actual(nullptr), error_fusion(false), resultado(nullptr),
+      valor_conteo(0), restantes_conteo(0) {
+    
+    if (prefijo_chunks) {
+        snprintf(prefijo, sizeof(prefijo), "%s", prefijo_chunks);
+    } else {
+        prefijoUnico(prefijo, sizeof(prefijo), "chunk");
+    }
+    
+    // Modo conteo solo si un contador por valor cabe en el presupuesto
+    if ((long long)rango_max - rango_min + 1 > MAX_CONTADORES) {
+        modo_conteo = false;
+        rango_min = 0;
+        rango_max = 65535;
+    }
+    
+    resumen = new Histograma(rango_min, rango_max);
+}
+
+ExternalSorter::~ExternalSorter() {
+    cerrarFusion();
+    
+    for (int i = 0; i < num_chunks; i++) {
+        char nombre[96];
+        nombreChunk(nombre, i);
+        remove(nombre);
+    }
+    
+    delete[] chunk_min;
+    delete[] chunk_max;
+    delete[] orden;
+    delete[] grupos;
+    delete resumen;
+}
+
+void ExternalSorter::prefijoUnico(char* destino, int tamano, const char* base) {
+    static unsigned int instancias = 0;
+    snprintf(destino, tamano, "%s_%ld_%u", base, (long)getpid(), instancias++);
+}
+
+void ExternalSorter::nombreChunk(char* nombre, int numero) const {
+    sprintf(nombre, "%s_%d.tmp", prefijo, numero);
+}
+
+void ExternalSorter::volcarBuffer() {
+    char nombre[96];
+    nombreChunk(nombre, num_chunks);
+    buffer.ordenarYVolcar(nombre);
+    registrarChunk(buffer_min, buffer_max);
+    buffer.vaciar();
+}
+
+void ExternalSorter::registrarChunk(int minimo, int maximo) {
+    if (num_chunks == capacidad_chunks) {
+        // Duplicar la capacidad de los arreglos de rangos
+        int nueva = capacidad_chunks == 0 ? 16 : capacidad_chunks * 2;
+        int* nuevo_min = new int[nueva];
+        int* nuevo_max = new int[nueva];
+        for (int i = 0; i < num_chunks; i++) {
+            nuevo_min[i] = chunk_min[i];
+            nuevo_max[i] = chunk_max[i];
+        }
+        delete[] chunk_min;
+        delete[] chunk_max;
+        chunk_min = nuevo_min;
+        chunk_max = nuevo_max;
+        capacidad_chunks = nueva;
+    }
+    
+    chunk_min[num_chunks] = minimo;
+    chunk_max[num_chunks] = maximo;
+    num_chunks++;
+}
+
+bool ExternalSorter::push(int valor) {
+    if (terminado) {
+        return false;
+    }
+    
+    // La primera lectura fuera del dominio vuelca los conteos como un
+    // chunk ordenado y se continúa con el buffer circular
+    if (modo_conteo && !resumen->enDominio(valor)) {
+        cambio_a_chunks = true;
+        lectura_cambio = valor;
+        if (total > 0) {
+            char nombre[96];
+            nombreChunk(nombre, num_chunks);
+            resumen->escribirOrdenado(nombre);
+            registrarChunk(resumen->getMinimo(), resumen->getMaximo());
+        }
+        modo_conteo = false;
+    }
+    
+    resumen->agregar(valor);
+    total++;
+    
+    if (modo_conteo) {
+        return true;
+    }
+    
+    if (buffer.estaLleno()) {
+        volcarBuffer();
+    }
+    if (buffer.estaVacio() || valor < buffer_min) {
+        buffer_min = valor;
+    }
+    if (buffer.estaVacio() || valor > buffer_max) {
+        buffer_max = valor;
+    }
+    buffer.insertar(valor);
+    
+    return true;
+}
+
+int ExternalSorter::push(const int* datos, int n) {
+    int agregados = 0;
+    
+    for (int i = 0; i < n; i++) {
+        if (!push(datos[i])) {
+            break;
+        }
+        agregados++;
+    }
+    
+    return agregados;
+}
+
+int ExternalSorter::pushAll(DataSource* fuente) {
+    int agregados = 0;
+    
+    while (fuente->hasMoreData()) {
+        if (!push(fuente->getNext())) {
+            break;
+        }
+        agregados++;
+    }
+    
+    return agregados;
+}
+
+bool ExternalSorter::finish() {
+    if (terminado) {
+        return !error_fusion;
+    }
+    terminado = true;
+    
+    if (modo_conteo) {
+        valor_conteo = resumen->getDominioMin();
+        restantes_conteo = resumen->getConteo(valor_conteo);
+        return true;
+    }
+    
+    if (!buffer.estaVacio()) {
+        volcarBuffer();
+    }
+    
+    agruparChunks();
+    
+    return true;
+}
+
+void ExternalSorter::agruparChunks() {
+    orden = new int[num_chunks];
+    grupos = new int[num_chunks + 1];
+    
+    // Chunks ordenados por su mínimo
+    for (int i = 0; i < num_chunks; i++) {
+        orden[i] = i;
+    }
+    ordenarPorClave(orden, num_chunks, chunk_min);
+    
+    // Un chunk abre un grupo nuevo si empieza en o después del máximo
+    // de todo lo anterior; si no, se solapa y se fusiona con el grupo
+    num_grupos = 0;
+    int maximo = 0;
+    chunks_copiados = 0;
+    
+    for (int i = 0; i < num_chunks; i++) {
+        int c = orden[i];
+        if (i == 0 || chunk_min[c] >= maximo) {
+            if (num_grupos > 0 && i - grupos[num_grupos - 1] == 1) {
+                chunks_copiados++;
+            }
+            grupos[num_grupos++] = i;
+            maximo = chunk_max[c];
+        } else if (chunk_max[c] > maximo) {
+            maximo = chunk_max[c];
+        }
+    }
+    grupos[num_grupos] = num_chunks;
+    
+    if (num_grupos > 0 && num_chunks - grupos[num_grupos - 1] == 1) {
+        chunks_copiados++;
+    }
+}
+
+DataSource* ExternalSorter::abrirGrupo(int g) {
+    int inicio = grupos[g];
+    int n = grupos[g + 1] - inicio;
+    
+    DataSource** fuentes = new DataSource*[n];
+    
+    for (int i = 0; i < n; i++) {
+        char nombre[96];
+        nombreChunk(nombre, orden[inicio + i]);
+        FileSource* archivo = new FileSource(nombre);
+        
+        if (!archivo->isOpen()) {
+            delete archivo;
+            for (int j = 0; j < i; j++) {
+                delete fuentes[j];
+            }
+            delete[] fuentes;
+            return nullptr;
+        }
+        
+        fuentes[i] = archivo;
+    }
+    
+    // Un chunk solo no necesita comparaciones
+    if (n == 1) {
+        DataSource* unico = fuentes[0];
+        delete[] fuentes;
+        return unico;
+    }
+    
+    return new MergeSource(fuentes, n);
+}
+
+bool ExternalSorter::siguiente(int& valor) {
+    if (!terminado) {
+        return false;
+    }
+    
+    if (modo_conteo) {
+        // Recorrer los contadores repitiendo cada valor
+        while (restantes_conteo == 0) {
+            if (valor_conteo >= resumen->getDominioMax()) {
+                return false;
+            }
+            valor_conteo++;
+            restantes_conteo = resumen->getConteo(valor_conteo);
+        }
+        restantes_conteo--;
+        valor = valor_conteo;
+        return true;
+    }
+    
+    // Los grupos no se solapan: se recorren uno tras otro
+    while (fuente_actual == nullptr || !fuente_actual->hasMoreData()) {
+        delete fuente_actual;
+        fuente_actual = nullptr;
+        
+        if (error_fusion || grupo_actual + 1 >= num_grupos) {
+            return false;
+        }
+        
+        grupo_actual++;
+        fuente_actual = abrirGrupo(grupo_actual);
+        if (fuente_actual == nullptr) {
+            error_fusion = true;
+            return false;
+        }
+    }
+    
+    valor = fuente_actual->getNext();
+    return true;
+}
+
+void ExternalSorter::cerrarFusion() {
+    delete resultado;
+    delete fuente_actual;
+    
+    resultado = nullptr;
+    fuente_actual = nullptr;
+}
+
+ExternalSorter::iterator ExternalSorter::begin() {
+    finish();
+    return iterator(this);
+}
+
+bool ExternalSorter::copiarArchivo(const char* nombre, int destino) {
+    int origen = open(nombre, O_RDONLY);
+    if (origen < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(origen, &info) != 0) {
+        close(origen);
+        return false;
+    }
+    
+    off_t restantes = info.st_size;
+    bool ok = true;
+    
+    while (restantes > 0) {
+        ssize_t n = -1;
+#ifdef __linux__
+        // Entre archivos regulares el kernel copia sin pasar por el proceso;
+        // hacia tuberías y sockets se usa sendfile
+        n = copy_file_range(origen, nullptr, destino, nullptr, restantes, 0);
+        if (n <= 0) {
+            n = sendfile(destino, origen, nullptr, restantes);
+        }
+#endif
+        if (n <= 0) {
+            char bloque[65536];
+            n = read(origen, bloque, sizeof(bloque));
+            if (n > 0 && write(destino, bloque, n) != n) {
+                n = -1;
+            }
+        }
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+        restantes -= n;
+    }
+    
+    close(origen);
+    return ok;
+}
+
+DataSource* ExternalSorter::getResultado() {
+    if (!finish()) {
+        return nullptr;
+    }
+    
+    if (resultado == nullptr) {
+        resultado = new Resultado(this);
+    }
+    
+    return resultado;
+}
+
+bool ExternalSorter::escribir(const char* nombre_archivo) {
+    if (!finish()) {
+        return false;
+    }
+    
+    FILE* salida = fopen(nombre_archivo, "w");
+    if (salida == nullptr) {
+        fprintf(stderr, "Error: No se pudo crear el archivo %s\n", nombre_archivo);
+        return false;
+    }
+    
+    bool ok = escribir(salida);
+    fclose(salida);
+    
+    return ok;
+}
+
+bool ExternalSorter::escribir(FILE* salida) {
+    if (!finish()) {
+        return false;
+    }
+    
+    // En modo conteo se escribe directo desde los contadores, continuando
+    // donde quedó la extracción con el iterador
+    if (modo_conteo) {
+        int desde = valor_conteo;
+        unsigned long long pendientes = restantes_conteo;
+        valor_conteo = resumen->getDominioMax();
+        restantes_conteo = 0;
+        return resumen->escribirOrdenado(salida, desde, pendientes);
+    }
+    
+    // Terminar el grupo en curso si ya se extrajeron valores
+    while (fuente_actual != nullptr && fuente_actual->hasMoreData()) {
+        if (fprintf(salida, "%d\n", fuente_actual->getNext()) < 0) {
+            return false;
+        }
+    }
+    
+    while (!error_fusion && grupo_actual + 1 < num_grupos) {
+        delete fuente_actual;
+        fuente_actual = nullptr;
+        grupo_actual++;
+        
+        // Un chunk sin solapamiento ya tiene el formato de la salida
+        if (grupos[grupo_actual + 1] - grupos[grupo_actual] == 1) {
+            char nombre[96];
+            nombreChunk(nombre, orden[grupos[grupo_actual]]);
+            if (fflush(salida) != 0 || !copiarArchivo(nombre, fileno(salida))) {
+                error_fusion = true;
+            }
+            continue;
+        }
+        
+        fuente_actual = abrirGrupo(grupo_actual);
+        if (fuente_actual == nullptr) {
+            error_fusion = true;
+            break;
+        }
+        
+        while (fuente_actual->hasMoreData()) {
+            if (fprintf(salida, "%d\n", fuente_actual->getNext()) < 0) {
+                // El consumidor cerró la tubería o el socket
+                return false;
+            }
+        }
+    }
+    
+    return !error_fusion && fflush(salida) == 0;
+}
+
+ExternalSorter::Resultado::Resultado(ExternalSorter* s)
+    : sorter(s), has_next(false), next_value(0) {
+    has_next = sorter->siguiente(next_value);
+}
+
+int ExternalSorter::Resultado::getNext() {
+    int valor_actual = next_value;
+    has_next = sorter->siguiente(next_value);
+    return valor_actual;
+}
@@ -10,7 +10,7 @@ FileSource::FileSource(const char* filename) : file(nullptr), has_more(false), n
     file = fopen(filename, "r");
     
     if (file == nullptr) {
-        printf("Error: No se pudo abrir el archivo %s\n", filename);
+        fprintf(stderr, "Error: No se pudo abrir el archivo %s\n", filename);
         return;
     }
     
@@ -0,0 +1,252 @@
+/**
+ * @file Histograma.cpp
+ * @brief Implementación de la clase Histograma
+ */
+
+#include "Histograma.h"
+#include <cstdio>
+#include <cstring>
+
+Histograma::Histograma(int min_dominio, int max_dominio)
+    : conteos(nullptr), dominio_min(min_dominio), dominio_max(max_dominio),
+      total(0), debajo(0), encima(0), valor_min(0), valor_max(0),
+      aproximados(nullptr) {
+    
+    // Contadores inicializados en cero
+    conteos = new unsigned long long[dominio_max - dominio_min + 1]();
+}
+
+Histograma::~Histograma() {
+    delete[] conteos;
+    delete[] aproximados;
+}
+
+void Histograma::agregar(int valor) {
+    if (total == 0 || valor < valor_min) {
+        valor_min = valor;
+    }
+    if (total == 0 || valor > valor_max) {
+        valor_max = valor;
+    }
+    total++;
+    
+    if (enDominio(valor)) {
+        conteos[valor - dominio_min]++;
+        return;
+    }
+    
+    if (valor < dominio_min) {
+        debajo++;
+    } else {
+        encima++;
+    }
+    
+    // Las cubetas se reservan con la primera lectura fuera del dominio
+    if (aproximados == nullptr) {
+        aproximados = new unsigned long long[2 * CUBETAS_MAGNITUD]();
+    }
+    aproximados[cubeta(valor)]++;
+}
+
+int Histograma::cubeta(int valor) {
+    unsigned long long magnitud = valor < 0 ? -(long long)valor : valor;
+    int indice;
+    
+    if (magnitud < 128) {
+        indice = (int)magnitud;
+    } else {
+        // Potencia de 2 (bit más alto) y los 6 bits que le siguen
+        int bit = 7;
+        while (magnitud >> (bit + 1)) {
+            bit++;
+        }
+        indice = 128 + (bit - 7) * 64 + (int)((magnitud >> (bit - 6)) - 64);
+    }
+    
+    // Negativos en orden inverso antes de los positivos
+    return valor < 0 ? CUBETAS_MAGNITUD - 1 - indice : CUBETAS_MAGNITUD + indice;
+}
+
+long long Histograma::centroCubeta(int indice) {
+    bool negativo = indice < CUBETAS_MAGNITUD;
+    int m = negativo ? CUBETAS_MAGNITUD - 1 - indice : indice - CUBETAS_MAGNITUD;
+    long long valor = m;
+    
+    if (m >= 128) {
+        int bit = 7 + (m - 128) / 64;
+        long long ancho = 1LL << (bit - 6);
+        valor = (64 + (m - 128) % 64) * ancho + (ancho - 1) / 2;
+    }
+    
+    return negativo ? -valor : valor;
+}
+
+int Histograma::buscarAproximado(unsigned long long k) const {
+    unsigned long long acumulado = 0;
+    long long valor = valor_max;
+    
+    for (int i = 0; i < 2 * CUBETAS_MAGNITUD; i++) {
+        acumulado += aproximados[i];
+        if (acumulado >= k) {
+            valor = centroCubeta(i);
+            break;
+        }
+    }
+    
+    if (valor < valor_min) {
+        return valor_min;
+    }
+    if (valor > valor_max) {
+        return valor_max;
+    }
+    return (int)valor;
+}
+
+unsigned long long Histograma::rangoPercentil(double p, unsigned long long total) {
+    // Rango más cercano: la lectura número ceil(p/100 * total)
+    unsigned long long rango = (unsigned long long)(p / 100.0 * total);
+    if ((double)rango < p / 100.0 * total) {
+        rango++;
+    }
+    if (rango < 1) {
+        rango = 1;
+    }
+    if (rango > total) {
+        rango = total;
+    }
+    return rango;
+}
+
+int Histograma::percentil(double p) const {
+    if (total == 0) {
+        return 0;
+    }
+    
+    unsigned long long rango = rangoPercentil(p, total);
+    
+    // Los extremos se conocen exactos
+    if (rango == 1) {
+        return valor_min;
+    }
+    if (rango == total) {
+        return valor_max;
+    }
+    
+    // Las lecturas fuera del dominio se aproximan por sus cubetas; las de
+    // debajo ocupan las primeras posiciones en el orden de las cubetas
+    if (rango <= debajo) {
+        return buscarAproximado(rango);
+    }
+    if (rango > total - encima) {
+        return buscarAproximado(rango - (total - encima) + debajo);
+    }
+    
+    unsigned long long acumulado = debajo;
+    int tamano = dominio_max - dominio_min + 1;
+    for (int i = 0; i < tamano; i++) {
+        acumulado += conteos[i];
+        if (acumulado >= rango) {
+            return dominio_min + i;
+        }
+    }
+    
+    return valor_max;
+}
+
+bool Histograma::guardar(const char* nombre_archivo) const {
+    FILE* archivo = fopen(nombre_archivo, "w");
+    if (archivo == nullptr) {
+        fprintf(stderr, "Error: No se pudo crear el archivo %s\n", nombre_archivo);
+        return false;
+    }
+    
+    fprintf(archivo, "total %llu\n", total);
+    fprintf(archivo, "minimo %d\n", valor_min);
+    fprintf(archivo, "maximo %d\n", valor_max);
+    fprintf(archivo, "p50 %d\n", percentil(50));
+    fprintf(archivo, "p90 %d\n", percentil(90));
+    fprintf(archivo, "p99 %d\n", percentil(99));
+    fprintf(archivo, "fuera_de_rango %llu\n", debajo + encima);
+    if (debajo + encima > 0) {
+        fprintf(archivo, "percentiles aproximados (error relativo < 1%%)\n");
+    }
+    
+    // Histograma: solo los valores que aparecieron (valor cantidad)
+    fprintf(archivo, "histograma\n");
+    int tamano = dominio_max - dominio_min + 1;
+    for (int i = 0; i < tamano; i++) {
+        if (conteos[i] > 0) {
+            fprintf(archivo, "%d %llu\n", dominio_min + i, conteos[i]);
+        }
+    }
+    
+    fclose(archivo);
+    
+    return true;
+}
+
+bool Histograma::escribirOrdenado(const char* nombre_archivo) const {
+    FILE* archivo = fopen(nombre_archivo, "w");
+    if (archivo == nullptr) {
+        fprintf(stderr, "Error: No se pudo crear el archivo %s\n", nombre_archivo);
+        return false;
+    }
+    
+    bool ok = escribirOrdenado(archivo);
+    fclose(archivo);
+    
+    return ok;
+}
+
+bool Histograma::escribirOrdenado(FILE* salida) const {
+    return escribirOrdenado(salida, dominio_min, conteos[0]);
+}
+
+bool Histograma::escribirOrdenado(FILE* salida, int desde,
+                                  unsigned long long pendientes) const {
+    char bloque[8192];
+    int tamano = dominio_max - dominio_min + 1;
+    
+    for (int i = desde - dominio_min; i < tamano; i++) {
+        unsigned long long restantes = i == desde - dominio_min ? pendientes : conteos[i];
+        if (restantes == 0) {
+            continue;
+        }
+        
+        // Formatear la línea una vez y replicarla dentro del bloque
+        char linea[16];
+        int largo = snprintf(linea, sizeof(linea), "%d\n", dominio_min + i);
+        unsigned long long por_bloque = sizeof(bloque) / largo;
+        if (por_bloque > restantes) {
+            por_bloque = restantes;
+        }
+        for (unsigned long long j = 0; j < por_bloque; j++) {
+            memcpy(bloque + j * largo, linea, largo);
+        }
+        
+        while (restantes > 0) {
+            unsigned long long copias = restantes < por_bloque ? restantes : por_bloque;
+            if (fwrite(bloque, largo, copias, salida) != copias) {
+                // El consumidor cerró la tubería o el socket
+                return false;
+            }
+            restantes -= copias;
+        }
+    }
+    
+    return fflush(salida) == 0;
+}
+
+void Histograma::mostrar() const {
+    if (total == 0) {
+        printf("Histograma vacío\n");
+        return;
+    }
+    
+    printf("Lecturas: %llu  min: %d  max: %d\n", total, valor_min, valor_max);
+    printf("p50: %d  p90: %d  p99: %d\n", percentil(50), percentil(90), percentil(99));
+    if (debajo + encima > 0) {
+        printf("Fuera de rango: %llu (percentiles aproximados, error < 1%%)\n",
+               debajo + encima);
+    }
+}
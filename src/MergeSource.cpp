@@ -0,0 +1,62 @@
+/**
+ * @file MergeSource.cpp
+ * @brief Implementación de la clase MergeSource
+ */
+
+#include "MergeSource.h"
+
+MergeSource::MergeSource(DataSource** srcs, int n)
+    : fuentes(srcs), num_fuentes(n), valores(nullptr), activos(nullptr),
+      num_activos(0) {
+    
+    valores = new int[num_fuentes];
+    activos = new bool[num_fuentes];
+    
+    // Leer el primer elemento de cada fuente
+    for (int i = 0; i < num_fuentes; i++) {
+        activos[i] = fuentes[i]->hasMoreData();
+        if (activos[i]) {
+            valores[i] = fuentes[i]->getNext();
+            num_activos++;
+        }
+    }
+}
+
+MergeSource::~MergeSource() {
+    for (int i = 0; i < num_fuentes; i++) {
+        delete fuentes[i];
+    }
+    delete[] fuentes;
+    delete[] valores;
+    delete[] activos;
+}
+
+int MergeSource::getNext() {
+    // Buscar el mínimo entre las fuentes con valor actual
+    int idx_min = -1;
+    for (int i = 0; i < num_fuentes; i++) {
+        if (activos[i] && (idx_min == -1 || valores[i] < valores[idx_min])) {
+            idx_min = i;
+        }
+    }
+    
+    if (idx_min == -1) {
+        return 0;
+    }
+    
+    int valor = valores[idx_min];
+    
+    // Avanzar solo en la fuente de la que se extrajo el mínimo
+    if (fuentes[idx_min]->hasMoreData()) {
+        valores[idx_min] = fuentes[idx_min]->getNext();
+    } else {
+        activos[idx_min] = false;
+        num_activos--;
+    }
+    
+    return valor;
+}
+
+bool MergeSource::hasMoreData() {
+    return num_activos > 0;
+}
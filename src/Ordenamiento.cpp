@@ -0,0 +1,63 @@
+/**
+ * @file Ordenamiento.cpp
+ * @brief Implementación del Merge Sort
+ */
+
+#include "Ordenamiento.h"
+
+/**
+ * @brief Merge Sort ascendente (bottom-up) sobre un arreglo auxiliar
+ * 
+ * Mezcla tramos de ancho 1, 2, 4... alternando entre datos y auxiliar;
+ * a igual clave se toma primero el del tramo izquierdo (estable).
+ * 
+ * @param clave Función que da la clave de un elemento
+ */
+template <typename Clave>
+static void mergeSort(int* datos, int n, Clave clave) {
+    if (n < 2) {
+        return;
+    }
+    
+    int* auxiliar = new int[n];
+    int* origen = datos;
+    int* destino = auxiliar;
+    
+    for (int ancho = 1; ancho < n; ancho *= 2) {
+        for (int inicio = 0; inicio < n; inicio += 2 * ancho) {
+            int medio = inicio + ancho < n ? inicio + ancho : n;
+            int fin = inicio + 2 * ancho < n ? inicio + 2 * ancho : n;
+            int i = inicio, j = medio, k = inicio;
+            
+            while (i < medio && j < fin) {
+                if (clave(origen[j]) < clave(origen[i])) {
+                    destino[k++] = origen[j++];
+                } else {
+                    destino[k++] = origen[i++];
+                }
+            }
+            while (i < medio) destino[k++] = origen[i++];
+            while (j < fin) destino[k++] = origen[j++];
+        }
+        
+        int* temp = origen;
+        origen = destino;
+        destino = temp;
+    }
+    
+    if (origen != datos) {
+        for (int i = 0; i < n; i++) {
+            datos[i] = origen[i];
+        }
+    }
+    
+    delete[] auxiliar;
+}
+
+void ordenarEnteros(int* datos, int n) {
+    mergeSort(datos, n, [](int valor) { return valor; });
+}
+
+void ordenarPorClave(int* indices, int n, const int* claves) {
+    mergeSort(indices, n, [claves](int indice) { return claves[indice]; });
+}
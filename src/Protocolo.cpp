@@ -0,0 +1,48 @@
+/**
+ * @file Protocolo.cpp
+ * @brief Implementación de las funciones del protocolo binario
+ */
+
+#include "Protocolo.h"
+
+unsigned short calcularCrc16(const unsigned char* datos, int largo) {
+    unsigned short crc = 0xFFFF;
+    
+    for (int i = 0; i < largo; i++) {
+        crc ^= (unsigned short)(datos[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            if (crc & 0x8000) {
+                crc = (unsigned short)((crc << 1) ^ 0x1021);
+            } else {
+                crc = (unsigned short)(crc << 1);
+            }
+        }
+    }
+    
+    return crc;
+}
+
+int codificarTrama(unsigned char* destino, unsigned int secuencia,
+                   const unsigned short* lecturas, int n) {
+    int pos = 0;
+    
+    destino[pos++] = TRAMA_SYNC_0;
+    destino[pos++] = TRAMA_SYNC_1;
+    
+    for (int i = 0; i < 4; i++) {
+        destino[pos++] = (unsigned char)(secuencia >> (8 * i));
+    }
+    destino[pos++] = (unsigned char)n;
+    
+    for (int i = 0; i < n; i++) {
+        destino[pos++] = (unsigned char)(lecturas[i] & 0xFF);
+        destino[pos++] = (unsigned char)(lecturas[i] >> 8);
+    }
+    
+    // El CRC no incluye los bytes de sincronía
+    unsigned short crc = calcularCrc16(destino + 2, pos - 2);
+    destino[pos++] = (unsigned char)(crc & 0xFF);
+    destino[pos++] = (unsigned char)(crc >> 8);
+    
+    return pos;
+}
@@ -7,12 +7,16 @@
 #include <fcntl.h>      // Para open()
 #include <unistd.h>     // Para read(), close()
 #include <termios.h>    // Para configuración serial
-#include <cstring>      // Para memset, strlen
+#include <cstring>      // Para memset, memmove
 #include <cstdio>       // Para printf
 
 SerialSource::SerialSource(const char* port_name, int max_reads) 
-    : fd(-1), buffer_pos(0), is_connected(false), 
-      max_readings(max_reads), readings_count(0) {
+    : fd(-1), buffer_inicio(0), buffer_fin(0), is_connected(false), 
+      max_readings(max_reads), readings_count(0),
+      has_pending(false), pending_value(0),
+      protocolo(PROTOCOLO_DESCONOCIDO), lote_pos(0), lote_len(0),
+      hay_secuencia(false), secuencia_esperada(0), lecturas_perdidas(0),
+      tramas_invalidas(0), bytes_descartados(0) {
     
     // Abrir el puerto serial
     fd = open(port_name, O_RDWR | O_NOCTTY);
@@ -89,15 +93,35 @@ SerialSource::~SerialSource() {
     }
 }
 
+bool SerialSource::asegurarBytes(int n) {
+    if (n > (int)sizeof(buffer)) {
+        return false;
+    }
+    
+    while (buffer_fin - buffer_inicio < n) {
+        // Mover los bytes pendientes al inicio para dejar espacio
+        if (buffer_inicio > 0) {
+            memmove(buffer, buffer + buffer_inicio, buffer_fin - buffer_inicio);
+            buffer_fin -= buffer_inicio;
+            buffer_inicio = 0;
+        }
+        
+        int leidos = read(fd, buffer + buffer_fin, sizeof(buffer) - buffer_fin);
+        if (leidos <= 0) {
+            // Timeout o error
+            return false;
+        }
+        buffer_fin += leidos;
+    }
+    
+    return true;
+}
+
 bool SerialSource::readLine(char* line, int max_len) {
     int pos = 0;
-    char c;
     
     while (pos < max_len - 1) {
-        int n = read(fd, &c, 1);
-        
-        if (n <= 0) {
-            // Timeout o error
+        if (!asegurarBytes(1)) {
             if (pos > 0) {
                 line[pos] = '\0';
                 return true;
@@ -105,6 +129,8 @@ bool SerialSource::readLine(char* line, int max_len) {
             return false;
         }
         
+        char c = (char)buffer[buffer_inicio++];
+        
         if (c == '\n') {
             line[pos] = '\0';
             return true;
@@ -119,16 +145,128 @@ bool SerialSource::readLine(char* line, int max_len) {
     return true;
 }
 
-int SerialSource::getNext() {
-    if (!is_connected) {
-        return 0;
+bool SerialSource::detectarProtocolo() {
+    // El texto solo contiene dígitos, espacios y saltos de línea; cada
+    // trama binaria empieza con 0xA5, así que aparece pronto un byte ajeno
+    int saltos = 0;
+    
+    for (int k = 0; k < (int)sizeof(buffer); k++) {
+        if (!asegurarBytes(k + 1)) {
+            if (k == 0) {
+                return false;
+            }
+            break;
+        }
+        
+        unsigned char c = buffer[buffer_inicio + k];
+        
+        if (c == '\n') {
+            saltos++;
+            if (saltos == 2) {
+                break;
+            }
+        } else if (!(c >= '0' && c <= '9') && c != '\r' && c != ' ' && c != '\t') {
+            protocolo = PROTOCOLO_BINARIO;
+            printf("Protocolo: binario\n");
+            return true;
+        }
+    }
+    
+    protocolo = PROTOCOLO_TEXTO;
+    printf("Protocolo: texto\n");
+    return true;
+}
+
+bool SerialSource::leerTrama() {
+    while (true) {
+        // Buscar los bytes de sincronía
+        if (!asegurarBytes(2)) {
+            return false;
+        }
+        if (buffer[buffer_inicio] != TRAMA_SYNC_0 ||
+            buffer[buffer_inicio + 1] != TRAMA_SYNC_1) {
+            buffer_inicio++;
+            bytes_descartados++;
+            continue;
+        }
+        
+        if (!asegurarBytes(TRAMA_CABECERA)) {
+            return false;
+        }
+        
+        const unsigned char* trama = buffer + buffer_inicio;
+        int n = trama[6];
+        
+        if (n == 0 || n > TRAMA_MAX_LECTURAS) {
+            // Sincronía falsa: reintentar desde el siguiente byte
+            tramas_invalidas++;
+            buffer_inicio++;
+            bytes_descartados++;
+            continue;
+        }
+        
+        int largo = TRAMA_CABECERA + 2 * n + 2;
+        if (!asegurarBytes(largo)) {
+            return false;
+        }
+        trama = buffer + buffer_inicio;
+        
+        unsigned short crc = (unsigned short)(trama[largo - 2] | (trama[largo - 1] << 8));
+        if (calcularCrc16(trama + 2, largo - 4) != crc) {
+            tramas_invalidas++;
+            buffer_inicio++;
+            bytes_descartados++;
+            continue;
+        }
+        
+        unsigned int secuencia = (unsigned int)trama[2] |
+                                 ((unsigned int)trama[3] << 8) |
+                                 ((unsigned int)trama[4] << 16) |
+                                 ((unsigned int)trama[5] << 24);
+        
+        // Un salto hacia adelante son lecturas perdidas; hacia atrás
+        // significa que el Arduino se reinició
+        if (hay_secuencia && secuencia != secuencia_esperada) {
+            unsigned int salto = secuencia - secuencia_esperada;
+            if (salto < 0x80000000u) {
+                lecturas_perdidas += salto;
+            }
+        }
+        hay_secuencia = true;
+        secuencia_esperada = secuencia + n;
+        
+        for (int i = 0; i < n; i++) {
+            lote[i] = trama[TRAMA_CABECERA + 2 * i] |
+                      (trama[TRAMA_CABECERA + 2 * i + 1] << 8);
+        }
+        lote_pos = 0;
+        lote_len = n;
+        
+        buffer_inicio += largo;
+        return true;
+    }
+}
+
+bool SerialSource::readValue(int& valor) {
+    if (protocolo == PROTOCOLO_DESCONOCIDO && !detectarProtocolo()) {
+        is_connected = false;
+        return false;
+    }
+    
+    if (protocolo == PROTOCOLO_BINARIO) {
+        if (lote_pos >= lote_len && !leerTrama()) {
+            is_connected = false;
+            return false;
+        }
+        valor = lote[lote_pos++];
+        return true;
     }
     
     char line[256];
     
     while (readLine(line, sizeof(line))) {
         // Convertir la línea a entero
-        int valor = 0;
+        valor = 0;
         bool es_numero = false;
         
         for (int i = 0; line[i] != '\0'; i++) {
@@ -142,14 +280,23 @@ int SerialSource::getNext() {
         }
         
         if (es_numero) {
-            readings_count++;
-            return valor;
+            return true;
         }
     }
     
     // Si no se pudo leer, marcar como desconectado
     is_connected = false;
-    return 0;
+    return false;
+}
+
+int SerialSource::getNext() {
+    if (!hasMoreData()) {
+        return 0;
+    }
+    
+    has_pending = false;
+    readings_count++;
+    return pending_value;
 }
 
 bool SerialSource::hasMoreData() {
@@ -162,5 +309,19 @@ bool SerialSource::hasMoreData() {
         return false;
     }
     
-    return true;
+    if (!has_pending) {
+        has_pending = readValue(pending_value);
+    }
+    
+    return has_pending;
+}
+
+void SerialSource::mostrarEstadisticas() const {
+    if (protocolo != PROTOCOLO_BINARIO) {
+        return;
+    }
+    
+    printf("Lecturas perdidas: %llu\n", lecturas_perdidas);
+    printf("Tramas inválidas: %d\n", tramas_invalidas);
+    printf("Bytes descartados: %llu\n", bytes_descartados);
 }
@@ -0,0 +1,63 @@
+/**
+ * @file SocketSource.cpp
+ * @brief Implementación de la clase SocketSource
+ */
+
+#include "SocketSource.h"
+#include <unistd.h>     // Para read(), close()
+#include <cstring>      // Para memmove
+
+SocketSource::SocketSource(int descriptor)
+    : fd(descriptor), buffer_pos(0), buffer_len(0), bytes_parciales(0) {
+}
+
+SocketSource::~SocketSource() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool SocketSource::recibir() {
+    char* bytes = (char*)buffer;
+    
+    // Conservar el entero incompleto de la lectura anterior
+    if (bytes_parciales > 0) {
+        memmove(bytes, bytes + buffer_len * sizeof(int), bytes_parciales);
+    }
+    buffer_pos = 0;
+    buffer_len = 0;
+    
+    while (buffer_len == 0) {
+        int n = read(fd, bytes + bytes_parciales, sizeof(buffer) - bytes_parciales);
+        if (n <= 0) {
+            return false;
+        }
+        bytes_parciales += n;
+        buffer_len = bytes_parciales / sizeof(int);
+    }
+    bytes_parciales -= buffer_len * sizeof(int);
+    
+    return true;
+}
+
+int SocketSource::getNext() {
+    if (!hasMoreData()) {
+        return 0;
+    }
+    return buffer[buffer_pos++];
+}
+
+bool SocketSource::hasMoreData() {
+    if (buffer_pos < buffer_len) {
+        return true;
+    }
+    if (fd < 0) {
+        return false;
+    }
+    if (!recibir()) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
@@ -5,17 +5,17 @@
 
 #include "DataSource.h"
 #include "SerialSource.h"
-#include "FileSource.h"
+#include "ExternalSorter.h"
+#include "Coordinador.h"
 #include "CircularBuffer.h"
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <csignal>
 #include <unistd.h>
 #include <sys/stat.h>
-
-void generarNombreChunk(char* buffer, int numero) {
-    sprintf(buffer, "chunk_%d.tmp", numero);
-}
+#include <sys/socket.h>
+#include <sys/un.h>
 
 // Detectar puerto Arduino disponible
 const char* detectarPuerto() {
@@ -34,7 +34,32 @@ const char* detectarPuerto() {
     return nullptr;
 }
 
-int capturarDatos(const char* puerto, int buffer_size, int max_lecturas) {
+// Conectar a un consumidor que escucha en un socket Unix
+FILE* conectarSocket(const char* ruta) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    
+    struct sockaddr_un direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    strncpy(direccion.sun_path, ruta, sizeof(direccion.sun_path) - 1);
+    
+    if (connect(fd, (struct sockaddr*)&direccion, sizeof(direccion)) != 0) {
+        printf("Error: No se pudo conectar a %s\n", ruta);
+        close(fd);
+        return nullptr;
+    }
+    
+    return fdopen(fd, "w");
+}
+
+// Con una ventana (CircularBuffer en modo anillo) se muestran la mediana y
+// los percentiles de las últimas lecturas al final de cada línea. Devuelve
+// -1 si el destino rechaza una lectura (por ejemplo, murió un worker)
+int capturarDatos(const char* puerto, int max_lecturas, DataSink& destino,
+                  CircularBuffer* ventana) {
     SerialSource* serial = new SerialSource(puerto, max_lecturas);
     
     if (!serial->isConnected()) {
@@ -43,150 +68,104 @@ int capturarDatos(const char* puerto, int buffer_size, int max_lecturas) {
         return 0;
     }
     
-    CircularBuffer buffer(buffer_size);
-    int num_chunks = 0;
     int total = 0;
     
-    printf("Recibiendo datos (buffer: %d)...\n\n", buffer_size);
+    printf("Recibiendo datos...\n\n");
     
     while (serial->hasMoreData()) {
         int valor = serial->getNext();
         
-        if (!serial->hasMoreData() && valor == 0) {
-            break;
+        if (ventana != nullptr) {
+            ventana->insertar(valor);
         }
         
         printf("%d ", valor);
-        if ((total + 1) % 10 == 0) printf("\n");
+        if ((total + 1) % 10 == 0) {
+            if (ventana != nullptr) {
+                printf(" | últimas %d: p50 %d  p90 %d  p99 %d",
+                       ventana->getTamano(), ventana->mediana(),
+                       ventana->percentil(90), ventana->percentil(99));
+            }
+            printf("\n");
+        }
         total++;
         
-        if (!buffer.insertar(valor)) {
-            char nombre[64];
-            generarNombreChunk(nombre, num_chunks);
-            buffer.ordenarYVolcar(nombre);
-            num_chunks++;
-            buffer.vaciar();
-            buffer.insertar(valor);
+        if (!destino.push(valor)) {
+            printf("\n\nError: El destino dejó de aceptar lecturas (%d recibidas)\n", total);
+            delete serial;
+            return -1;
         }
     }
     
-    if (!buffer.estaVacio()) {
-        char nombre[64];
-        generarNombreChunk(nombre, num_chunks);
-        buffer.ordenarYVolcar(nombre);
-        num_chunks++;
-        buffer.vaciar();
-    }
+    printf("\n\nDatos recibidos: %d\n", total);
+    serial->mostrarEstadisticas();
     
     delete serial;
     
-    printf("\n\nDatos recibidos: %d\n", total);
-    printf("Archivos temporales: %d\n\n", num_chunks);
-    
-    return num_chunks;
+    return total;
 }
 
-bool fusionarArchivos(int num_chunks, const char* salida_final) {
-    if (num_chunks == 0) {
-        return false;
-    }
-    
-    printf("Fusionando archivos...\n");
+int main(int argc, char* argv[]) {
+    const char* puerto = nullptr;
+    int buffer_size = 100;
+    int max_lecturas = 0;
+    int rango_min = 0;        // Dominio del Arduino por defecto
+    int rango_max = 65535;
+    const char* salida = "output.sorted.txt";
+    int tamano_ventana = 0;   // Sin monitoreo por defecto
+    int num_workers = 1;      // Sin procesos worker por defecto
+    const char* stats = nullptr;  // Por defecto <salida>.stats
     
-    DataSource** fuentes = new DataSource*[num_chunks];
-    int* valores = new int[num_chunks];
-    bool* activos = new bool[num_chunks];
+    // Separar opciones (--rango MIN:MAX, --salida DESTINO, --ventana N,
+    // --workers P, --stats RUTA) de los argumentos posicionales
+    const char* posicionales[3] = { nullptr, nullptr, nullptr };
+    int num_posicionales = 0;
     
-    for (int i = 0; i < num_chunks; i++) {
-        char nombre[64];
-        generarNombreChunk(nombre, i);
-        fuentes[i] = new FileSource(nombre);
-        
-        if (!((FileSource*)fuentes[i])->isOpen()) {
-            for (int j = 0; j <= i; j++) {
-                delete fuentes[j];
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rango") == 0 && i + 1 < argc) {
+            i++;
+            if (sscanf(argv[i], "%d:%d", &rango_min, &rango_max) != 2 ||
+                rango_min > rango_max) {
+                printf("Rango inválido: %s (usar MIN:MAX)\n", argv[i]);
+                return 1;
             }
-            delete[] fuentes;
-            delete[] valores;
-            delete[] activos;
-            return false;
-        }
-        
-        if (fuentes[i]->hasMoreData()) {
-            valores[i] = fuentes[i]->getNext();
-            activos[i] = fuentes[i]->hasMoreData();
-        } else {
-            activos[i] = false;
+        } else if (strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+            salida = argv[++i];
+        } else if (strcmp(argv[i], "--ventana") == 0 && i + 1 < argc) {
+            tamano_ventana = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            num_workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+            stats = argv[++i];
+        } else if (num_posicionales < 3) {
+            posicionales[num_posicionales++] = argv[i];
         }
     }
     
-    FILE* salida = fopen(salida_final, "w");
-    if (salida == nullptr) {
-        for (int i = 0; i < num_chunks; i++) {
-            delete fuentes[i];
-        }
-        delete[] fuentes;
-        delete[] valores;
-        delete[] activos;
-        return false;
+    // El resumen va junto a la salida; con un flujo solo si se pide --stats
+    char ruta_stats[512];
+    bool es_flujo = strcmp(salida, "-") == 0 || strncmp(salida, "unix:", 5) == 0;
+    if (stats == nullptr && !es_flujo) {
+        snprintf(ruta_stats, sizeof(ruta_stats), "%s.stats", salida);
+        stats = ruta_stats;
     }
     
-    int escritos = 0;
-    
-    while (true) {
-        int idx_min = -1;
-        int val_min = 0;
-        
-        for (int i = 0; i < num_chunks; i++) {
-            if (activos[i] || fuentes[i]->hasMoreData()) {
-                if (idx_min == -1 || valores[i] < val_min) {
-                    idx_min = i;
-                    val_min = valores[i];
-                }
-            }
-        }
-        
-        if (idx_min == -1) {
-            break;
-        }
-        
-        fprintf(salida, "%d\n", val_min);
-        escritos++;
-        
-        if (fuentes[idx_min]->hasMoreData()) {
-            valores[idx_min] = fuentes[idx_min]->getNext();
-            activos[idx_min] = fuentes[idx_min]->hasMoreData();
-        } else {
-            activos[idx_min] = false;
-        }
+    // Con "--salida -" los datos van a stdout y los mensajes a stderr
+    int fd_datos = -1;
+    if (strcmp(salida, "-") == 0) {
+        fd_datos = dup(STDOUT_FILENO);
+        dup2(STDERR_FILENO, STDOUT_FILENO);
     }
     
-    fclose(salida);
+    // Si el consumidor se va, fprintf falla en lugar de terminar el proceso
+    signal(SIGPIPE, SIG_IGN);
     
-    for (int i = 0; i < num_chunks; i++) {
-        delete fuentes[i];
-    }
-    delete[] fuentes;
-    delete[] valores;
-    delete[] activos;
-    
-    printf("Elementos ordenados: %d\n", escritos);
-    printf("Resultado: %s\n\n", salida_final);
-    
-    return true;
-}
-
-int main(int argc, char* argv[]) {
     printf("E-Sort - Ordenamiento externo\n");
     printf("================================\n\n");
     
-    const char* puerto = nullptr;
-    int buffer_size = 100;
-    int max_lecturas = 0;
-    
     // Detectar puerto automáticamente si no se especifica
-    if (argc > 1) {
-        puerto = argv[1];
+    if (posicionales[0] != nullptr) {
+        puerto = posicionales[0];
     } else {
         printf("Buscando Arduino...\n");
         puerto = detectarPuerto();
@@ -198,28 +177,99 @@ int main(int argc, char* argv[]) {
         printf("Encontrado: %s\n\n", puerto);
     }
     
-    if (argc > 2) {
-        buffer_size = atoi(argv[2]);
+    if (posicionales[1] != nullptr) {
+        buffer_size = atoi(posicionales[1]);
     }
-    if (argc > 3) {
-        max_lecturas = atoi(argv[3]);
+    if (posicionales[2] != nullptr) {
+        max_lecturas = atoi(posicionales[2]);
+    }
+    
+    // Con varios workers el coordinador reparte por rangos entre procesos
+    ExternalSorter* sorter = nullptr;
+    Coordinador* coordinador = nullptr;
+    DataSink* destino;
+    if (num_workers > 1) {
+        printf("Modo particionado: %d workers\n", num_workers);
+        coordinador = new Coordinador(num_workers, buffer_size, rango_min, rango_max);
+        destino = coordinador;
+    } else {
+        sorter = new ExternalSorter(buffer_size, rango_min, rango_max);
+        if (sorter->enModoConteo()) {
+            printf("Modo conteo\n");
+        } else {
+            printf("Rango demasiado amplio para contar, se usarán chunks\n");
+        }
+        destino = sorter;
+    }
+    
+    CircularBuffer* ventana = nullptr;
+    if (tamano_ventana > 0) {
+        ventana = new CircularBuffer(tamano_ventana, true);
     }
     
     // Capturar datos
-    int num_chunks = capturarDatos(puerto, buffer_size, max_lecturas);
+    int recibidos = capturarDatos(puerto, max_lecturas, *destino, ventana);
+    delete ventana;
     
-    if (num_chunks == 0) {
-        printf("No se recibieron datos\n");
+    if (recibidos <= 0) {
+        if (recibidos == 0) {
+            printf("No se recibieron datos\n");
+        }
+        delete destino;
         return 1;
     }
     
-    // Fusionar
-    const char* salida = "output.sorted.txt";
-    if (!fusionarArchivos(num_chunks, salida)) {
-        printf("Error al fusionar archivos\n");
+    if (sorter != nullptr && sorter->cambioAChunks()) {
+        printf("Lectura fuera de rango (%d): se pasó de conteo a chunks\n",
+               sorter->getLecturaCambio());
+    }
+    
+    // El resumen está listo antes de fusionar
+    destino->getResumen().mostrar();
+    if (stats != nullptr && destino->getResumen().guardar(stats)) {
+        printf("Resumen: %s\n", stats);
+    }
+    printf("\n");
+    
+    bool ok = destino->finish();
+    
+    if (ok && sorter != nullptr && sorter->getNumChunks() > 0) {
+        printf("Chunks: %d en %d grupos (%d sin fusionar)\n", sorter->getNumChunks(),
+               sorter->getNumGrupos(), sorter->getChunksCopiados());
+        printf("Fusionando archivos...\n");
+    }
+    
+    // Un reparto muy desigual indica entrada ordenada o con deriva
+    if (coordinador != nullptr) {
+        for (int i = 0; i < coordinador->getNumWorkers(); i++) {
+            printf("Worker %d: %llu lecturas\n", i, coordinador->getLecturasWorker(i));
+        }
+    }
+    
+    // La fusión final se envía al consumidor a medida que se produce
+    if (ok) {
+        if (fd_datos >= 0 || strncmp(salida, "unix:", 5) == 0) {
+            FILE* flujo = fd_datos >= 0 ? fdopen(fd_datos, "w") : conectarSocket(salida + 5);
+            ok = flujo != nullptr && destino->escribir(flujo);
+            if (flujo != nullptr) {
+                fclose(flujo);
+            }
+        } else {
+            ok = destino->escribir(salida);
+        }
+    }
+    
+    unsigned long long ordenados = destino->getTotal();
+    delete destino;
+    
+    if (!ok) {
+        printf("Error al escribir %s\n", salida);
         return 1;
     }
     
+    printf("Elementos ordenados: %llu\n", ordenados);
+    printf("Resultado: %s\n\n", salida);
+    
     printf("Listo!\n");
     
     return 0;
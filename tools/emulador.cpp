@@ -0,0 +1,160 @@
+/**
+ * @file emulador.cpp
+ * @brief Emulador del Arduino sobre una pseudo-terminal (pty)
+ * 
+ * Crea una pty, enlaza su extremo esclavo en una ruta fija y, cuando
+ * esort abre el puerto, envía lecturas aleatorias en tramas binarias (o
+ * en texto). Puede omitir o corromper tramas para ejercitar la
+ * resincronización y el conteo de lecturas perdidas de SerialSource.
+ * 
+ * Por defecto genera una lectura cada 50 ms, como test.ino, y envía una
+ * trama cada TRAMA_MAX_ESPERA_MS; con intervalo 0 envía sin pausas.
+ * 
+ * Uso: ./esort_emulador [lecturas] [enlace] [perdida_%] [corrupcion_%] [texto]
+ *                       [intervalo_ms]
+ */
+
+#include "Protocolo.h"
+#include <fcntl.h>      // Para posix_openpt()
+#include <unistd.h>     // Para write(), close(), symlink()
+#include <poll.h>       // Para detectar la conexión
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Tiempo que esort espera antes de limpiar el puerto (ver SerialSource)
+const int ESPERA_CONEXION_MS = 2500;
+
+bool escribirTodo(int fd, const unsigned char* datos, int largo) {
+    while (largo > 0) {
+        int n = write(fd, datos, largo);
+        if (n <= 0) {
+            return false;
+        }
+        datos += n;
+        largo -= n;
+    }
+    return true;
+}
+
+// Con el esclavo cerrado el maestro reporta POLLHUP
+void esperarConexion(int maestro) {
+    while (true) {
+        struct pollfd pfd;
+        pfd.fd = maestro;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        poll(&pfd, 1, 100);
+        if (!(pfd.revents & POLLHUP)) {
+            return;
+        }
+        usleep(100000);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int lecturas = 1000;
+    const char* enlace = "/tmp/ttyESORT";
+    int perdida = 0;
+    int corrupcion = 0;
+    bool texto = false;
+    int intervalo = 50;   // Milisegundos entre lecturas, como test.ino
+    
+    if (argc > 1) lecturas = atoi(argv[1]);
+    if (argc > 2) enlace = argv[2];
+    if (argc > 3) perdida = atoi(argv[3]);
+    if (argc > 4) corrupcion = atoi(argv[4]);
+    if (argc > 5) texto = strcmp(argv[5], "texto") == 0;
+    if (argc > 6) intervalo = atoi(argv[6]);
+    
+    // Lecturas por trama: las que se generan antes de la espera máxima
+    int por_trama = TRAMA_MAX_LECTURAS;
+    if (intervalo > 0 && TRAMA_MAX_ESPERA_MS / intervalo < por_trama) {
+        por_trama = TRAMA_MAX_ESPERA_MS / intervalo > 0 ? TRAMA_MAX_ESPERA_MS / intervalo : 1;
+    }
+    
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        printf("Error: No se pudo crear la pty\n");
+        return 1;
+    }
+    
+    unlink(enlace);
+    if (symlink(ptsname(maestro), enlace) != 0) {
+        printf("Error: No se pudo crear el enlace %s\n", enlace);
+        close(maestro);
+        return 1;
+    }
+    
+    printf("Puerto emulado: %s -> %s\n", enlace, ptsname(maestro));
+    printf("Esperando a esort...\n");
+    fflush(stdout);
+    
+    esperarConexion(maestro);
+    usleep(ESPERA_CONEXION_MS * 1000);
+    
+    srand(1);
+    int enviadas = 0;
+    int omitidas = 0;
+    int tramas_omitidas = 0;
+    int tramas_corruptas = 0;
+    unsigned int secuencia = 0;
+    long long bytes = 0;
+    
+    while (secuencia < (unsigned int)lecturas) {
+        unsigned short lote[TRAMA_MAX_LECTURAS];
+        int n = lecturas - (int)secuencia;
+        if (n > por_trama) {
+            n = por_trama;
+        }
+        for (int i = 0; i < n; i++) {
+            lote[i] = (unsigned short)(rand() % 65536);
+        }
+        
+        unsigned char trama[TRAMA_MAX_BYTES + 16 * TRAMA_MAX_LECTURAS];
+        int largo = 0;
+        
+        if (texto) {
+            for (int i = 0; i < n; i++) {
+                largo += sprintf((char*)trama + largo, "%u\r\n", lote[i]);
+            }
+        } else {
+            largo = codificarTrama(trama, secuencia, lote, n);
+        }
+        secuencia += n;
+        
+        // Las lecturas del lote tardan en generarse, como en el Arduino
+        if (intervalo > 0) {
+            usleep(n * intervalo * 1000);
+        }
+        
+        if (rand() % 100 < perdida) {
+            omitidas += n;
+            tramas_omitidas++;
+            continue;
+        }
+        if (!texto && rand() % 100 < corrupcion) {
+            trama[2 + rand() % (largo - 2)] ^= 0x10;
+            tramas_corruptas++;
+        }
+        
+        if (!escribirTodo(maestro, trama, largo)) {
+            printf("esort cerró el puerto\n");
+            break;
+        }
+        enviadas += n;
+        bytes += largo;
+    }
+    
+    // Dar tiempo a que esort lea lo pendiente antes de colgar
+    usleep(500000);
+    close(maestro);
+    unlink(enlace);
+    
+    printf("Lecturas enviadas: %d (%lld bytes, %.2f bytes/lectura)\n",
+           enviadas, bytes, enviadas > 0 ? (double)bytes / enviadas : 0.0);
+    printf("Lecturas omitidas: %d en %d tramas\n", omitidas, tramas_omitidas);
+    printf("Tramas corrompidas: %d\n", tramas_corruptas);
+    
+    return 0;
+}